@@ -0,0 +1,134 @@
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "collision.h"
+#include "constants.h"
+#include "player_util.h"
+#include "villain.h"
+
+/**
+ * Compares find_collision() against the list-based version it replaced,
+ * for the doodler vs. bullet test done by check_villain_bullet_collision().
+ * Build it with 'make bench-collision' and run it with
+ * 'node bin/bench_collision.js'.
+ */
+
+const size_t BENCH_CALLS = 1000000;
+
+/**
+ * The list-based separating axis test that find_collision() used before
+ * shapes were cached, kept here as the baseline.
+ */
+static list_t *old_get_edges(list_t *shape) {
+  list_t *edges = list_init(list_size(shape), free);
+  for (size_t i = 0; i < list_size(shape); i++) {
+    vector_t *vec = malloc(sizeof(vector_t));
+    assert(vec);
+    *vec =
+        vec_subtract(*(vector_t *)list_get(shape, i % list_size(shape)),
+                     *(vector_t *)list_get(shape, (i + 1) % list_size(shape)));
+    list_add(edges, vec);
+  }
+  return edges;
+}
+
+static vector_t old_get_max_min_projections(list_t *shape, vector_t unit_axis) {
+  double min = __DBL_MAX__;
+  double max = -__DBL_MAX__;
+  for (size_t i = 0; i < list_size(shape); i++) {
+    double proj = vec_dot(*(vector_t *)list_get(shape, i), unit_axis);
+    min = fmin(min, proj);
+    max = fmax(max, proj);
+  }
+  return (vector_t){max, min};
+}
+
+static collision_info_t old_compare_collision(list_t *shape1, list_t *shape2,
+                                              double *min_overlap) {
+  collision_info_t info = {.collided = false, .axis = {0, 0}};
+  list_t *edges1 = old_get_edges(shape1);
+  for (size_t i = 0; i < list_size(edges1); i++) {
+    vector_t edge = *(vector_t *)list_get(edges1, i);
+    vector_t axis = {-edge.y, edge.x};
+    double len = vec_get_length(axis);
+    vector_t unit_axis = {axis.x / len, axis.y / len};
+    vector_t proj1 = old_get_max_min_projections(shape1, unit_axis);
+    vector_t proj2 = old_get_max_min_projections(shape2, unit_axis);
+    double overlap = fmin(proj1.x, proj2.x) - fmax(proj1.y, proj2.y);
+    if (overlap <= 0) {
+      list_free(edges1);
+      return info;
+    }
+    if (overlap < *min_overlap) {
+      *min_overlap = overlap;
+      info.axis = unit_axis;
+    }
+  }
+  list_free(edges1);
+  info.collided = true;
+  return info;
+}
+
+static collision_info_t old_find_collision(body_t *body1, body_t *body2) {
+  list_t *shape1 = body_get_shape(body1);
+  list_t *shape2 = body_get_shape(body2);
+  double c1_overlap = __DBL_MAX__;
+  double c2_overlap = __DBL_MAX__;
+  collision_info_t collision1 = old_compare_collision(shape1, shape2, &c1_overlap);
+  collision_info_t collision2 = old_compare_collision(shape2, shape1, &c2_overlap);
+  list_free(shape1);
+  list_free(shape2);
+  if (!collision1.collided) {
+    return collision1;
+  }
+  if (!collision2.collided) {
+    return collision2;
+  }
+  return c1_overlap < c2_overlap ? collision1 : collision2;
+}
+
+typedef collision_info_t (*collision_func_t)(body_t *, body_t *);
+
+/**
+ * Times calls of a collision function and prints how many it makes a second.
+ *
+ * @return the number of calls that found a collision, so none are optimized out
+ */
+static size_t bench(const char *name, collision_func_t find, body_t *user,
+                    body_t *bullet) {
+  size_t hits = 0;
+  clock_t start = clock();
+  for (size_t i = 0; i < BENCH_CALLS; i++) {
+    hits += find(user, bullet).collided;
+  }
+  double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+  printf("%-12s %10.0f calls/s\n", name, BENCH_CALLS / seconds);
+  return hits;
+}
+
+int main(void) {
+  body_t *user = make_user(OUTER_RADIUS, INNER_RADIUS, VEC_ZERO);
+  body_t *near = make_bullet(BULLET_RADIUS, (vector_t){10, 30});
+  body_t *far = make_bullet(BULLET_RADIUS, (vector_t){200, 30});
+
+  // Both versions must agree before their speeds are compared
+  assert(find_collision(user, near).collided == old_find_collision(user, near).collided);
+  assert(find_collision(user, far).collided == old_find_collision(user, far).collided);
+
+  printf("doodler vs. overlapping bullet\n");
+  size_t hits = bench("list-based", old_find_collision, user, near);
+  hits += bench("cached", find_collision, user, near);
+  printf("doodler vs. distant bullet\n");
+  hits += bench("list-based", old_find_collision, user, far);
+  hits += bench("cached", find_collision, user, far);
+  printf("collisions %zu\n", hits);
+
+  body_free(user);
+  body_free(near);
+  body_free(far);
+  collision_cache_free();
+  return 0;
+}
@@ -0,0 +1,300 @@
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "asset.h"
+#include "asset_cache.h"
+#include "collision.h"
+#include "constants.h"
+#include "entity.h"
+#include "platforms.h"
+#include "player_util.h"
+#include "sdl_wrapper.h"
+#include "villain.h"
+
+/**
+ * Microbenchmarks of the game's hot paths.
+ * Each benchmark is run a few times to warm up, then timed over a number of
+ * repetitions. One JSON object per benchmark is printed to stdout, with the
+ * median, 99th percentile, fastest and mean time per operation.
+ * Build and run it with 'make bench'. Flags are `--reps N`, `--warmup N`
+ * and `--filter TEXT`, which only runs benchmarks whose names contain TEXT.
+ * The native build opens SDL's software renderer on the dummy video driver,
+ * so no display is needed and the SDL paths (texture loads, bounding boxes
+ * against the real window size) are measured. The headless build
+ * ('make bench-wasm') has no renderer, so those cases time only the game's
+ * side of each call.
+ */
+
+const size_t DEFAULT_REPS = 30;
+const size_t DEFAULT_WARMUP = 5;
+const size_t CALLS_PER_REP = 100000;
+const size_t ASSET_BODIES = 1000;
+const unsigned int BENCH_SEED = 1;
+
+/**
+ * A benchmark. setup() and teardown() run around each repetition of run()
+ * and are not timed; either may be NULL.
+ */
+typedef struct {
+  const char *name;
+  void (*setup)(void);
+  /** Runs one repetition and returns how many operations it did */
+  size_t (*run)(void);
+  void (*teardown)(void);
+} bench_case_t;
+
+/**
+ * Results of the benchmarked calls are added here so they aren't optimized
+ * out.
+ */
+static volatile uintptr_t sink = 0;
+
+static scene_t *scene;
+static platform_index_t *platforms;
+static body_t *user;
+static body_t *near_bullet;
+static body_t *far_bullet;
+static body_t **asset_bodies;
+
+static uint64_t now_ns(void) {
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return (uint64_t)time.tv_sec * 1000000000ull + time.tv_nsec;
+}
+
+static void release_platforms(void) {
+  size_t n = platform_index_size(platforms);
+  for (size_t i = 0; i < n; i++) {
+    platform_pool_release(platform_index_get(platforms, i));
+  }
+  platform_index_remove_lowest(platforms, n);
+}
+
+static void setup_platforms(void) { platforms_init(platforms, scene); }
+
+static size_t run_collision_overlap(void) {
+  for (size_t i = 0; i < CALLS_PER_REP; i++) {
+    sink += find_collision(user, near_bullet).collided;
+  }
+  return CALLS_PER_REP;
+}
+
+static size_t run_collision_separated(void) {
+  for (size_t i = 0; i < CALLS_PER_REP; i++) {
+    sink += find_collision(user, far_bullet).collided;
+  }
+  return CALLS_PER_REP;
+}
+
+static void setup_landing(void) {
+  setup_platforms();
+  // Standing on the first platform and falling, so every call lands
+  vector_t feet = {FIRST_PLATFORM_LOC.x,
+                   FIRST_PLATFORM_LOC.y + PLATFORM_HEIGHT / 2.0 + OUTER_RADIUS};
+  body_set_centroid(user, feet);
+  body_set_velocity(user, (vector_t){0, -100});
+}
+
+static void setup_airborne(void) {
+  setup_platforms();
+  body_set_centroid(user, (vector_t){MAX.x / 2, MAX.y / 2});
+  body_set_velocity(user, (vector_t){0, -100});
+}
+
+static size_t run_user_bottom(void) {
+  for (size_t i = 0; i < CALLS_PER_REP; i++) {
+    sink += find_collision_with_user_bottom(platforms, scene, user);
+  }
+  return CALLS_PER_REP;
+}
+
+static size_t run_platforms_init(void) {
+  platforms_init(platforms, scene);
+  return platform_index_size(platforms);
+}
+
+static void setup_scrolled(void) {
+  setup_platforms();
+  // The camera has moved up half a screen, so the lower half is gone
+  remove_platform(platforms, scene, MAX.y / 2);
+}
+
+static size_t run_platforms_create(void) {
+  size_t before = platform_index_size(platforms);
+  screen_move_platforms_create(platforms, scene, 0, MAX.y / 2);
+  return platform_index_size(platforms) - before;
+}
+
+static size_t run_asset_cache(void) {
+  for (size_t i = 0; i < CALLS_PER_REP; i++) {
+    const char *path = *IMAGE_PATHS[i % NUM_IMAGE_PATHS];
+    sink += (uintptr_t)asset_cache_obj_get_or_create(ASSET_IMAGE, path);
+  }
+  return CALLS_PER_REP;
+}
+
+static void setup_asset_bodies(void) {
+  for (size_t i = 0; i < ASSET_BODIES; i++) {
+    asset_make_image_with_body(BULLET_PATH, asset_bodies[i]);
+  }
+}
+
+static size_t run_asset_remove_body(void) {
+  for (size_t i = 0; i < ASSET_BODIES; i++) {
+    asset_remove_body(asset_bodies[i]);
+  }
+  return ASSET_BODIES;
+}
+
+static size_t run_bounding_box(void) {
+  size_t n = platform_index_size(platforms);
+  for (size_t i = 0; i < CALLS_PER_REP; i++) {
+    SDL_Rect rect =
+        sdl_get_body_bounding_box(platform_index_get(platforms, i % n));
+    sink += rect.x + rect.w;
+  }
+  return CALLS_PER_REP;
+}
+
+static const bench_case_t BENCHES[] = {
+    {"find_collision/overlap", NULL, run_collision_overlap, NULL},
+    {"find_collision/separated", NULL, run_collision_separated, NULL},
+    {"find_collision_with_user_bottom/landing", setup_landing,
+     run_user_bottom, release_platforms},
+    {"find_collision_with_user_bottom/airborne", setup_airborne,
+     run_user_bottom, release_platforms},
+    {"platforms_init", NULL, run_platforms_init, release_platforms},
+    {"screen_move_platforms_create", setup_scrolled, run_platforms_create,
+     release_platforms},
+    {"asset_cache_obj_get_or_create", NULL, run_asset_cache, NULL},
+    {"asset_remove_body", setup_asset_bodies, run_asset_remove_body, NULL},
+    {"sdl_get_body_bounding_box", setup_platforms, run_bounding_box,
+     release_platforms},
+};
+
+static int compare_doubles(const void *a, const void *b) {
+  double x = *(const double *)a;
+  double y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+/** Returns the sorted values' value at a percentile, nearest rank */
+static double percentile(const double *sorted, size_t n, double percent) {
+  size_t rank = (size_t)ceil(percent / 100 * n);
+  return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+static double run_once(const bench_case_t *bench, size_t *ops) {
+  if (bench->setup != NULL) {
+    bench->setup();
+  }
+  uint64_t start = now_ns();
+  *ops = bench->run();
+  uint64_t elapsed = now_ns() - start;
+  if (bench->teardown != NULL) {
+    bench->teardown();
+  }
+  assert(*ops > 0);
+  return (double)elapsed / *ops;
+}
+
+static void run_bench(const bench_case_t *bench, size_t warmup, size_t reps) {
+  size_t ops = 0;
+  for (size_t i = 0; i < warmup; i++) {
+    run_once(bench, &ops);
+  }
+  double *ns_per_op = malloc(sizeof(double) * reps);
+  assert(ns_per_op != NULL);
+  double total = 0;
+  for (size_t i = 0; i < reps; i++) {
+    ns_per_op[i] = run_once(bench, &ops);
+    total += ns_per_op[i];
+  }
+  qsort(ns_per_op, reps, sizeof(double), compare_doubles);
+  printf("{\"name\":\"%s\",\"reps\":%zu,\"ops_per_rep\":%zu,"
+         "\"median_ns\":%.3f,\"p99_ns\":%.3f,\"min_ns\":%.3f,"
+         "\"mean_ns\":%.3f}\n",
+         bench->name, reps, ops, percentile(ns_per_op, reps, 50),
+         percentile(ns_per_op, reps, 99), ns_per_op[0], total / reps);
+  fflush(stdout);
+  free(ns_per_op);
+}
+
+static void usage(const char *program) {
+  fprintf(stderr, "usage: %s [--reps N] [--warmup N] [--filter TEXT]\n",
+          program);
+  exit(1);
+}
+
+int main(int argc, char *argv[]) {
+  size_t reps = DEFAULT_REPS;
+  size_t warmup = DEFAULT_WARMUP;
+  const char *filter = NULL;
+  for (int i = 1; i < argc; i++) {
+    if (i + 1 >= argc) {
+      usage(argv[0]);
+    }
+    if (strcmp(argv[i], "--reps") == 0) {
+      reps = strtoul(argv[++i], NULL, 10);
+    } else if (strcmp(argv[i], "--warmup") == 0) {
+      warmup = strtoul(argv[++i], NULL, 10);
+    } else if (strcmp(argv[i], "--filter") == 0) {
+      filter = argv[++i];
+    } else {
+      usage(argv[0]);
+    }
+  }
+  if (reps == 0) {
+    usage(argv[0]);
+  }
+
+  srand(BENCH_SEED);
+#ifndef HEADLESS
+  // Render offscreen in software unless the caller picked other drivers
+  SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+  SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+  SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+#endif
+  sdl_init(MIN, MAX);
+  asset_cache_init();
+  scene = scene_init();
+  entity_lists_init();
+  platform_pool_init(scene);
+  platforms = platform_index_init(TOTAL_PLATFORMS);
+
+  user = make_user(OUTER_RADIUS, INNER_RADIUS, VEC_ZERO);
+  entity_add(scene, user);
+  near_bullet = make_bullet(BULLET_RADIUS, (vector_t){10, 30});
+  far_bullet = make_bullet(BULLET_RADIUS, (vector_t){200, 30});
+  asset_bodies = malloc(sizeof(body_t *) * ASSET_BODIES);
+  assert(asset_bodies != NULL);
+  for (size_t i = 0; i < ASSET_BODIES; i++) {
+    asset_bodies[i] = make_bullet(BULLET_RADIUS, (vector_t){i, 0});
+  }
+
+  for (size_t i = 0; i < sizeof(BENCHES) / sizeof(BENCHES[0]); i++) {
+    if (filter == NULL || strstr(BENCHES[i].name, filter) != NULL) {
+      run_bench(&BENCHES[i], warmup, reps);
+    }
+  }
+
+  for (size_t i = 0; i < ASSET_BODIES; i++) {
+    body_free(asset_bodies[i]);
+  }
+  free(asset_bodies);
+  body_free(near_bullet);
+  body_free(far_bullet);
+  asset_reset_asset_list();
+  platform_index_free(platforms);
+  platform_pool_free();
+  scene_free(scene);
+  entity_lists_free();
+  collision_cache_free();
+  asset_cache_destroy();
+  return 0;
+}
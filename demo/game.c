@@ -5,9 +5,11 @@
 #include <string.h>
 #include <time.h>
 
+#include "arena.h"
 #include "asset.h"
 #include "asset_cache.h"
 #include "collision.h"
+#include "entity.h"
 #include "forces.h"
 #include "sdl_wrapper.h"
 #include "villain.h"
@@ -16,6 +18,11 @@
 #include "game_util.h"
 #include "constants.h"
 #include "player_util.h"
+#include "profiler.h"
+#include "sim.h"
+#include "sound_bank.h"
+#include "text.h"
+#include "timestep.h"
 
 
 struct state {
@@ -23,11 +30,20 @@ struct state {
   scene_t *scene;
   int16_t score;
 
-  list_t *platforms_list;
-  body_t *villain;
+  platform_index_t *platforms;
+  entity_handle_t villain;
+
+  // world position of the bottom left corner of the view
+  vector_t camera;
 
   bool game_over;
   double timer;
+
+  timestep_t timestep;
+
+  glyph_atlas_t *score_glyphs;
+  text_label_t *gameover_top;
+  text_label_t *gameover_bottom;
 };
 
 void on_key(char key, key_event_type_t type, double held_time, void *state) {
@@ -63,21 +79,13 @@ void update_score(state_t *state){
   char score[32];  
   sprintf(score, "Score: %d", state->score);
 
-  TTF_Font *font = TTF_OpenFont(FONT, 30);
-  SDL_Color color = {0, 0, 0};
-  SDL_Surface *message = TTF_RenderText_Solid(font, score, color);
-  SDL_Rect *font_rect = sdl_get_rect(FONT_POSITION.x, FONT_POSITION.y, FONT_SIZE.x, FONT_SIZE.y);
-  sdl_render_text(message, font_rect);
-
-  SDL_FreeSurface(message);
-  free(font_rect);
-  TTF_CloseFont(font);
+  SDL_Rect *font_rect = sdl_get_frame_rect(FONT_POSITION.x, FONT_POSITION.y, FONT_SIZE.x, FONT_SIZE.y);
+  glyph_atlas_draw(state->score_glyphs, score, font_rect);
 }
 
 void calculate_score(state_t *state){
-  body_t *start_dot = scene_get_body(state->scene, 1);
-  double height = body_get_centroid(start_dot).y;
-  state->score = height * -1;
+  // the score is the altitude the camera has climbed to
+  state->score = state->camera.y;
   
   update_score(state);
 }
@@ -85,39 +93,28 @@ void calculate_score(state_t *state){
 void reset_game(state_t *state){
 
   // Reset Score
-  body_t *starting_dot = scene_get_body(state->scene, 1);
-  body_set_centroid(starting_dot, VEC_ZERO);
+  state->camera = VEC_ZERO;
   state->score = 0;
 
   // Resets User Position
   body_set_centroid(state->user, START_POS);
 
   //Removes Villain & Bullets 
-  if (state->villain != NULL){
-
-    for (ssize_t i = scene_bodies(state->scene) - 1; i >= 0; i--){
-      body_t *body = scene_get_body(state->scene, i);
-      void *info = body_get_info(body);
-      if(info != NULL && strcmp((char *)info, BULLET_INFO) == 0){
-        scene_remove_body(state->scene, i);
-        asset_remove_body(body);
-      }
-    }
-    scene_remove_body(state->scene, body_index_in_scene(state->scene, state->villain));
-    asset_remove_body(state->villain);
-    state->villain = NULL;
+  // Removing the villain makes its handle stale, so it reads as NULL after
+  body_t *villain = entity_get_body(state->villain);
+  if (villain != NULL){
+    bullet_pool_release_all();
+    entity_remove(villain);
   }
   // Reset Plateforms
-  ssize_t platform_count = list_size(state->platforms_list);
-  for (ssize_t i = 0; i < platform_count; i++) {
-    body_t *platform = list_get(state->platforms_list, i);
-      scene_remove_body(state->scene, body_index_in_scene(state->scene, platform));
-      list_remove(state->platforms_list, i);
-      platform_count--;
-      i--;
+  size_t platform_count = platform_index_size(state->platforms);
+  for (size_t i = 0; i < platform_count; i++) {
+    platform_pool_release(platform_index_get(state->platforms, i));
   }
+  platform_index_remove_lowest(state->platforms, platform_count);
 
-  platforms_init(state->platforms_list, state->scene);
+  platforms_init(state->platforms, state->scene);
+  timestep_reset(&state->timestep);
 }
 
 
@@ -132,17 +129,11 @@ void gameover_screen(state_t *state){
   sprintf(over_top, "GAME OVER");
   sprintf(over_bottom, "Score: %d", state->score);
 
-  TTF_Font *font = TTF_OpenFont(GAMEOVER_FONT, 30);
-  SDL_Color color = {0, 0, 0};
-
-  SDL_Surface *message_top = TTF_RenderText_Solid(font, over_top, color);
-  SDL_Surface *message_bottom = TTF_RenderText_Solid(font, over_bottom, color);
+  SDL_Rect *font_rect_top = sdl_get_frame_rect(MAX.x / 4.4, MAX.y/3.5, FONT_SIZE.x * 3, FONT_SIZE.y * 3);
+  SDL_Rect *font_rect_bottom = sdl_get_frame_rect(MAX.x / 4.4, (MAX.y/3.5) + (FONT_SIZE.y * 3), FONT_SIZE.x * 3, FONT_SIZE.y * 3);
 
-  SDL_Rect *font_rect_top = sdl_get_rect(MAX.x / 4.4, MAX.y/3.5, FONT_SIZE.x * 3, FONT_SIZE.y * 3);
-  SDL_Rect *font_rect_bottom = sdl_get_rect(MAX.x / 4.4, (MAX.y/3.5) + (FONT_SIZE.y * 3), FONT_SIZE.x * 3, FONT_SIZE.y * 3);
-
-  sdl_render_text(message_top, font_rect_top);
-  sdl_render_text(message_bottom, font_rect_bottom);
+  text_label_draw(state->gameover_top, over_top, font_rect_top);
+  text_label_draw(state->gameover_bottom, over_bottom, font_rect_bottom);
 
   sdl_show();
 
@@ -150,18 +141,10 @@ void gameover_screen(state_t *state){
     reset_game(state);
     state->game_over = false;
   }
-  
-  SDL_FreeSurface(message_top);
-  SDL_FreeSurface(message_bottom);
-
-  free(font_rect_top);
-  free(font_rect_bottom);
-
-  TTF_CloseFont(font);
 }
 
 bool check_game_over(state_t *state){
-  if (body_get_centroid(state->user).y < 0){
+  if (body_get_centroid(state->user).y < state->camera.y){
     state->game_over = true;
     state->timer = 0;
     return true;
@@ -175,52 +158,113 @@ bool check_game_over(state_t *state){
   return false;
 }
 
+/**
+ * Advances the game world by one fixed physics step.
+ *
+ * @param state the game state
+ * @param dt the length of the step in seconds
+ */
+void step_physics(state_t *state, double dt){
+  PROFILE_ZONE("step_physics");
+  {
+    PROFILE_ZONE("gravity");
+    // apply gravity + most recent velocity
+    vector_t user_velocity = body_get_velocity(state->user);
+    body_set_velocity(state->user, (vector_t){user_velocity.x, user_velocity.y - ACC * dt});
+  }
+  {
+    PROFILE_ZONE("scene_tick");
+    // advance all physics in scene
+    scene_tick(state->scene, dt);
+  }
+  {
+    PROFILE_ZONE("update_villain");
+    //updates villain conditions relative to the game 
+    update_villain(&(state->villain), state->score, state->scene, dt, state->camera.y);
+  }
+  {
+    PROFILE_ZONE("find_collision_with_user_bottom");
+    if (find_collision_with_user_bottom(state->platforms, state->scene, state->user)) {
+      user_bounce(state->user);
+    }
+  }
+  {
+    PROFILE_ZONE("screen_move");
+    screen_move(state->user, entity_get_body(state->villain), &state->camera);
+  }
+  {
+    PROFILE_ZONE("remove_platform");
+    remove_platform(state->platforms, state->scene, state->camera.y);
+  }
+  {
+    PROFILE_ZONE("screen_move_platforms_create");
+    screen_move_platforms_create(state->platforms, state->scene, state->score, state->camera.y);
+  }
+  {
+    PROFILE_ZONE("platforms_bounce_off_wall");
+    platforms_bounce_off_wall();
+  }
+
+  // User wrap edges
+  wrap_edges(state->user);
+}
+
 state_t *emscripten_init() {
   asset_cache_init();
   sdl_init(MIN, MAX);
 
   state_t *state = malloc(sizeof(state_t));
   state->score = 0;
-  srand(time(NULL));
+  state->camera = VEC_ZERO;
+  srand(sim_get_seed());
   state->scene = scene_init();
+  entity_lists_init();
 
   state->game_over = false;
   state->timer = 0;
+  state->timestep = timestep_init(PHYSICS_DT, MAX_PHYSICS_SUBSTEPS);
 
   // Creates user and initial velocity
   body_t *user = make_user(OUTER_RADIUS, INNER_RADIUS, VEC_ZERO);
   body_set_centroid(user, START_POS);
   state->user = user;
-  scene_add_body(state->scene, user);
-
-  // Create starting position dot
-  body_t *starting_dot = start_dot(VEC_ZERO);
-  scene_add_body(state->scene, starting_dot);
+  entity_add(state->scene, user);
 
   // Assigns images to their related bodies
   asset_make_image(BACKGROUND_PATH, (SDL_Rect){MIN.x, MIN.y, MAX.x, MAX.y});
   asset_make_image_with_body(USER_PATH, user);
 
-  // init platform list
-  state->platforms_list = list_init(TOTAL_PLATFORMS, NULL);
+  // init platform index and the pool that recycles platforms
+  state->platforms = platform_index_init(TOTAL_PLATFORMS);
+  platform_pool_init(state->scene);
+
+  // park the villain's bullets in the scene up front
+  bullet_pool_init(state->scene);
 
   // init platforms
-  platforms_init(state->platforms_list, state->scene);
+  platforms_init(state->platforms, state->scene);
 
   sdl_on_key(on_key);
-  TTF_Init();
+
+  // Score digits are drawn from an atlas, game over text from cached labels
+  state->score_glyphs = glyph_atlas_init(FONT, TEXT_FONT_SIZE, SCORE_GLYPHS);
+  state->gameover_top = text_label_init(GAMEOVER_FONT, TEXT_FONT_SIZE);
+  state->gameover_bottom = text_label_init(GAMEOVER_FONT, TEXT_FONT_SIZE);
+
   //initalize background music
-  Mix_Init(0);
-  Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 1024);
   SDL_play_music(BACKGROUND_MUSIC_PATH);
 
-  //initalize villain to NULL
-  state->villain = NULL;
+  //no villain until it spawns
+  state->villain = ENTITY_NO_HANDLE;
 
   return state;
 }
 
 bool emscripten_main(state_t *state) {
+  PROFILE_ZONE("frame");
+  // Everything allocated from the frame arena last frame is released here
+  frame_arena_reset();
+
   // Shows game over screen
   static bool game_over_sound_played = false;
 
@@ -234,53 +278,51 @@ bool emscripten_main(state_t *state) {
   } else {
     game_over_sound_played = false;
   }
-  double dt = time_since_last_tick();
-
-  // apply gravity + most recent velocity
-  vector_t user_velocity = body_get_velocity(state->user);                     
-  body_set_velocity(state->user, (vector_t){user_velocity.x, user_velocity.y - ACC * dt});
-
-  // advance all physics in scene
-  scene_tick(state->scene, dt);
- 
-  //updates villain conditions relative to the game 
-  update_villain(&(state->villain), state->score, state->scene, dt);
-
-  if (find_collision_with_user_bottom(state->platforms_list, state->scene, state->user)) {
-    user_bounce(state->user);
-  }
-
-  screen_move(state->user, state->scene);
-  remove_platform(state->platforms_list, state->scene);
-  screen_move_platforms_create(state->platforms_list, state->scene, state->score);
-  
-  platforms_bounce_off_wall(state->scene);
-
-  // User wrap edges
-  wrap_edges(state->user);
-
-  //Check if game is over
-  if (check_game_over(state) == true){
-    return false;
+  // run as many fixed physics steps as the elapsed frame time covers
+  size_t substeps = timestep_advance(&state->timestep, time_since_last_tick());
+  for (size_t i = 0; i < substeps; i++) {
+    step_physics(state, state->timestep.step);
+
+    //Check if game is over
+    if (check_game_over(state) == true){
+      return false;
+    }
   }
 
   sdl_clear();
-  sdl_render_scene(state->scene);
-  list_t *body_assets = asset_get_asset_list();
-  
-  for (size_t i = 0; i < list_size(body_assets); i++) {
-    asset_render(list_get(body_assets, i));
+  sdl_set_camera(state->camera);
+  {
+    PROFILE_ZONE("sdl_render_scene");
+    sdl_render_scene(state->scene);
+  }
+  {
+    PROFILE_ZONE("asset_render_all");
+    asset_render_all();
+  }
+  {
+    PROFILE_ZONE("calculate_score");
+    calculate_score(state);
+  }
+  {
+    PROFILE_ZONE("sdl_show");
+    sdl_show();
   }
-
-  calculate_score(state);
-
-  sdl_show();
   return false;
 }
 
 void emscripten_free(state_t *state) {
-  list_free(asset_get_asset_list());
+  asset_reset_asset_list();
   scene_free(state->scene);
+  entity_lists_free();
+  platform_index_free(state->platforms);
+  platform_pool_free();
+  bullet_pool_free();
+  glyph_atlas_free(state->score_glyphs);
+  text_label_free(state->gameover_top);
+  text_label_free(state->gameover_bottom);
   asset_cache_destroy();
+  sound_bank_free();
+  frame_arena_free();
+  collision_cache_free();
   free(state);
 }
\ No newline at end of file
@@ -0,0 +1,100 @@
+#ifndef __ARENA_H__
+#define __ARENA_H__
+
+#include <stddef.h>
+
+/**
+ * A bump allocator for short-lived memory.
+ * Allocations are never freed one at a time; arena_reset() releases all of
+ * them at once. Once an arena has grown to fit its busiest cycle, it serves
+ * every allocation without touching the heap.
+ */
+typedef struct arena arena_t;
+
+/**
+ * Counts of an arena's work since it was made.
+ */
+typedef struct {
+  /** Calls to arena_reset() */
+  size_t resets;
+  /** Allocations served */
+  size_t allocations;
+  /** Bytes handed out, including alignment padding */
+  size_t bytes;
+  /** The most bytes handed out between two resets */
+  size_t peak_bytes;
+  /** Times the arena itself went to the heap for more memory */
+  size_t heap_allocations;
+} arena_stats_t;
+
+/**
+ * Allocates an empty arena.
+ *
+ * @param capacity the number of bytes to reserve up front
+ * @return the new arena
+ */
+arena_t *arena_init(size_t capacity);
+
+/**
+ * Frees an arena and everything allocated from it.
+ *
+ * @param arena the arena to free
+ */
+void arena_free(arena_t *arena);
+
+/**
+ * Allocates memory from an arena, aligned for any type.
+ * If the arena is full, a new chunk is taken from the heap;
+ * the next arena_reset() grows the arena so that won't happen again.
+ *
+ * @param arena the arena
+ * @param size the number of bytes
+ * @return the memory, valid until the next arena_reset()
+ */
+void *arena_alloc(arena_t *arena, size_t size);
+
+/**
+ * Allocates an array from an arena.
+ *
+ * @param arena the arena
+ * @param count the number of elements
+ * @param size the size of each element
+ * @return the array, valid until the next arena_reset()
+ */
+void *arena_alloc_array(arena_t *arena, size_t count, size_t size);
+
+/**
+ * Releases everything allocated from an arena.
+ *
+ * @param arena the arena
+ */
+void arena_reset(arena_t *arena);
+
+/**
+ * Returns an arena's counters.
+ *
+ * @param arena the arena
+ * @return the counters
+ */
+arena_stats_t arena_get_stats(arena_t *arena);
+
+/**
+ * Returns the arena for memory that only lives for one frame,
+ * making it on first use. It is reset at the start of each frame.
+ *
+ * @return the frame arena
+ */
+arena_t *frame_arena(void);
+
+/**
+ * Releases everything allocated from the frame arena.
+ * Called at the start of each frame.
+ */
+void frame_arena_reset(void);
+
+/**
+ * Frees the frame arena.
+ */
+void frame_arena_free(void);
+
+#endif // #ifndef __ARENA_H__
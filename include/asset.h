@@ -47,22 +47,27 @@ void asset_make_text(const char *filepath, SDL_Rect bounding_box,
                      const char *text, color_t color);
 
 /**
- * Resets the internal asset list by freeing all assets and creating a new empty
- * list. This is useful when transitioning between scenes or levels.
+ * Resets the internal asset list by freeing all assets, leaving it empty.
+ * This is useful when transitioning between scenes or levels,
+ * and when the game is freed.
  */
 void asset_reset_asset_list();
 
 /**
- * Returns the internal list of all assets that have been created.
+ * Returns the number of assets in the internal asset list.
  *
- * @return a pointer to the list containing all assets
+ * @return the number of assets
  */
-list_t *asset_get_asset_list();
+size_t asset_count();
 
 /**
  * Removes and destroys all image assets associated with the given body.
  * This is typically called when a body is destroyed to clean up its visual
- * representation.
+ * representation. A table keyed by body address maps each body to its most
+ * recently created image, and each image links to the previous one on the
+ * same body, so the body's images are found without scanning the asset list.
+ * The asset list is doubly linked, so this takes time proportional to the
+ * number of images on the body, not the number of assets.
  *
  * @param body the body whose associated assets should be removed
  */
@@ -74,6 +79,11 @@ void asset_remove_body(body_t *body);
  */
 void asset_render(asset_t *asset);
 
+/**
+ * Renders every asset in the internal asset list, in the order they were made.
+ */
+void asset_render_all();
+
 /**
  * Frees the memory allocated for the asset.
  * @param asset the asset to free
@@ -5,8 +5,20 @@
 #include <stddef.h>
 
 /**
- * Initializes the empty, list-based global asset cache. The caller must then
- * destroy the cache with `asset_cache_destroy` when done.
+ * Lookup counters for the asset cache.
+ */
+typedef struct {
+  /** Lookups that returned an already loaded object */
+  size_t hits;
+  /** Lookups that had to load the object from disk */
+  size_t misses;
+} asset_cache_stats_t;
+
+/**
+ * Initializes the global asset cache, a hash table keyed by interned path
+ * and font size. The image paths in constants.c are hashed and interned here,
+ * but not loaded until first use. The caller must then destroy the cache with
+ * `asset_cache_destroy` when done.
  */
 void asset_cache_init();
 
@@ -22,6 +34,10 @@ void asset_cache_destroy();
  * If the object doesn't exist, adds a new entry to the asset cache and returns
  * the pointer to the newly created object.
  *
+ * Lookups take constant time. The image path constants in constants.h are
+ * found by their address alone; any other path is hashed by its contents,
+ * so a reused buffer is looked up by whatever it holds now.
+ *
  * Example:
  * ```
  * char *img_path = "assets/image.png";
@@ -37,4 +53,22 @@ void asset_cache_destroy();
  */
 void *asset_cache_obj_get_or_create(asset_type_t ty, const char *filepath);
 
+/**
+ * Gets the font at filepath opened at the given point size, opening it the
+ * first time the pair is requested. The cache owns the font.
+ *
+ * @param filepath the filepath to the .ttf file
+ * @param font_size the point size of the font
+ * @return the cached font
+ */
+TTF_Font *asset_cache_font_get_or_create(const char *filepath,
+                                         size_t font_size);
+
+/**
+ * Returns the hit and miss counts since asset_cache_init().
+ *
+ * @return a copy of the counters
+ */
+asset_cache_stats_t asset_cache_get_stats();
+
 #endif // #ifndef __ASSET_CACHE_H__
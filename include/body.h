@@ -201,7 +201,8 @@ void body_remove(body_t *body);
 bool body_is_removed(body_t *body);
 
 /**
- * Frees memory allocated for a body.
+ * Frees memory allocated for a body, and removes its image assets
+ * (see asset_remove_body()).
  *
  * @param body the pointer to the body
  */
@@ -1,12 +1,17 @@
 #ifndef __COLLISION_H__
 #define __COLLISION_H__
 
+#include "arena.h"
 #include "body.h"
 #include "list.h"
 #include "vector.h"
 #include "scene.h"
+#include "vec_array.h"
 #include <stdbool.h>
 
+/** Declared in platforms.h, which includes this header */
+typedef struct platform_index platform_index_t;
+
 /**
  * Represents the status of a collision between two shapes.
  * The shapes are either not colliding, or they are colliding along some axis.
@@ -23,8 +28,87 @@ typedef struct {
   vector_t axis;
 } collision_info_t;
 
+/**
+ * An axis-aligned bounding box.
+ */
+typedef struct {
+  vector_t min;
+  vector_t max;
+} aabb_t;
+
+/**
+ * The most vertices a collision_shape_t holds inline.
+ * Shapes with more vertices are stored on the heap.
+ */
+enum { COLLISION_MAX_VERTICES = 32 };
+
+/**
+ * A convex polygon in a contiguous array, ready for separating axis tests.
+ * Vertices are stored relative to an origin (the body's centroid),
+ * so the shape can be tested at any position without being copied.
+ * normals[i] is the unit normal of the edge from vertices[i] to
+ * vertices[i + 1], computed once when the shape is built.
+ * bounds is the box around the vertices, also relative to the origin.
+ * vertices and normals point into storage unless the shape is too big for it,
+ * so a shape must not be copied once it is initialized.
+ */
+typedef struct {
+  size_t num_vertices;
+  vector_t *vertices;
+  vector_t *normals;
+  aabb_t bounds;
+  vector_t storage[2 * COLLISION_MAX_VERTICES];
+} collision_shape_t;
+
+/**
+ * Fills a collision shape from an array of vertices.
+ * Allocates if there are more than COLLISION_MAX_VERTICES vertices,
+ * so every initialized shape must be freed with collision_shape_free().
+ *
+ * @param shape the shape to fill
+ * @param vertices the polygon's vertices, in order
+ * @param origin the point the stored vertices are made relative to
+ */
+void collision_shape_init(collision_shape_t *shape, vec_array_t *vertices,
+                          vector_t origin);
+
+/**
+ * Frees the memory a collision shape allocated, if any.
+ * The shape may then be initialized again.
+ *
+ * @param shape the shape to free
+ */
+void collision_shape_free(collision_shape_t *shape);
+
+/**
+ * Computes the status of the collision between two collision shapes.
+ * Does not allocate.
+ *
+ * @param shape1 the first shape
+ * @param position1 where the first shape's origin is in the scene
+ * @param shape2 the second shape
+ * @param position2 where the second shape's origin is in the scene
+ * @return whether the shapes are colliding, and if so, the collision axis
+ */
+collision_info_t find_shape_collision(const collision_shape_t *shape1,
+                                      vector_t position1,
+                                      const collision_shape_t *shape2,
+                                      vector_t position2);
+
+/**
+ * Returns whether two boxes overlap. Boxes that only touch overlap.
+ *
+ * @param box1 the first box
+ * @param box2 the second box
+ * @return whether they overlap
+ */
+bool aabb_overlaps(aabb_t box1, aabb_t box2);
+
 /**
  * Computes the status of the collision between two bodies.
+ * Each body's shape is cached the first time it is tested,
+ * so repeat tests do no heap allocation.
+ * Bodies whose bounding boxes are apart are rejected without a SAT test.
  *
  * @param body1 the first body
  * @param body2 the second body
@@ -33,15 +117,53 @@ typedef struct {
  */
 collision_info_t find_collision(body_t *body1, body_t *body2);
 
+/**
+ * Drops a body's cached collision shape.
+ * The scene calls this for each body it frees; call it before freeing
+ * a body that was tested for collisions but never added to the scene.
+ *
+ * @param body the body being removed
+ */
+void collision_forget_body(body_t *body);
+
+/**
+ * Drops every cached collision shape and frees the cache.
+ * Call this when the scene is freed.
+ */
+void collision_cache_free(void);
+
+/**
+ * Returns a body's bounding box in the scene.
+ * The box around the body's shape is cached with its collision shape,
+ * relative to the centroid, so this only adds the current centroid.
+ *
+ * @param body the body
+ * @return its bounding box
+ */
+aabb_t collision_body_aabb(body_t *body);
+
+/**
+ * Copies a body's vertices into an arena.
+ * They are read from the body's cached collision shape, so body_get_shape()
+ * only runs when the body's shape has changed.
+ *
+ * @param body the body
+ * @param arena the arena to allocate the vertices from
+ * @param num_vertices set to the number of vertices
+ * @return the vertices, valid until the arena is reset
+ */
+vector_t *collision_copy_vertices(body_t *body, arena_t *arena,
+                                  size_t *num_vertices);
+
 /**
  * Determines whether the bottom of the user collides with a platform
  *
- * @param platforms_list the list of the platforms in the scene
+ * @param platforms the platforms in the scene, ordered by height
  * @param scene the scene in the state
  * @param user the doodler
  * @return whether the doodler bottom collides with the top of a platform
  */
-bool find_collision_with_user_bottom(list_t *platforms_list, scene_t *scene, body_t *user);
+bool find_collision_with_user_bottom(platform_index_t *platforms, scene_t *scene, body_t *user);
 
 /**
  * Handles user bounce physics when collides with platform
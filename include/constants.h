@@ -27,6 +27,10 @@ extern const double DOODLER_BOUNCE_VELO_Y;
 extern double DOODLE_LR_VELO;
 extern const double ACC;
 
+// fixed physics step
+extern const double PHYSICS_DT;
+extern const size_t MAX_PHYSICS_SUBSTEPS;
+
 // doodler constants
 extern const double OUTER_RADIUS;
 extern const double INNER_RADIUS;
@@ -41,7 +45,6 @@ extern const size_t VILLAIN_NUM_POINTS;
 extern const vector_t VILLAIN_START_POS;
 extern const color_t VILLAIN_COLOR;
 extern const char *VILLAIN_PATH;
-extern const char *VILLAIN_INFO;
 extern const vector_t HOVER_RIGHT;
 extern const vector_t HOVER_LEFT;
 
@@ -50,9 +53,9 @@ extern const vector_t HOVER_LEFT;
 extern const double BULLET_RADIUS;
 extern const double BULLET_NUM_POINTS;
 extern const color_t BULLET_COLOR;
-extern const char *BULLET_INFO;
 extern const char *BULLET_PATH;
 extern const vector_t BULLET_VELOCITY;
+extern const size_t BULLET_POOL_CAPACITY;
 
 
 // velocity stuff for platforms
@@ -64,16 +67,16 @@ extern const double VEL_MULT_PROB;
 extern const size_t PLATFORM_HEIGHT;
 extern const size_t PLATFORM_WIDTH;
 
-extern const char *STEADY_PLATFORM_INFO;
 extern const char *STEADY_PLATFORM_PATH;
-extern const char *MOVING_PLATFORM_INFO;
 extern const char *MOVING_PLATFORM_PATH;
-extern const char *BREAKING_PLATFORM_INFO;
 extern const char *BREAKING_PLATFORM_PATH;
-extern const char *BROKEN_PLATFORM_INFO;
 extern const char *BROKEN_PLATFORM_PATH;
 extern const char *PLATFORM_BROKE;
 
+// every image path above, interned by asset_cache_init()
+extern const char **const IMAGE_PATHS[];
+extern const size_t NUM_IMAGE_PATHS;
+
 // platform init stuff
 extern const size_t NUM_PLATFORM_CHANNELS;
 extern const size_t CHANNEL_HEIGHT;
@@ -94,6 +97,8 @@ extern const vector_t FONT_POSITION;
 extern const vector_t FONT_SIZE;
 extern const char *GAMEOVER_FONT;
 extern const char *FONT;
+extern const size_t TEXT_FONT_SIZE;
+extern const char *SCORE_GLYPHS;
 
 //Music Constants
 extern const char *BACKGROUND_MUSIC_PATH;
@@ -102,4 +107,8 @@ extern const char *BREAKING_PLATFORM_SOUND_PATH;
 extern const char *PLATFORM_BOUNCE_SOUND_PATH;
 extern const char *VILLAIN_SPAWN_SOUND_PATH;
 extern const char *GAME_OVER_SOUND_PATH;
-extern const char *USER_DEATH_SOUND_PATH;
\ No newline at end of file
+extern const char *USER_DEATH_SOUND_PATH;
+
+// every sound effect path above, decoded by sound_bank_init()
+extern const char **const SOUND_PATHS[];
+extern const size_t NUM_SOUND_PATHS;
\ No newline at end of file
@@ -0,0 +1,163 @@
+#ifndef __ENTITY_H__
+#define __ENTITY_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "body.h"
+#include "list.h"
+#include "scene.h"
+
+/**
+ * The kinds of bodies in the game.
+ * A body's kind is stored in its info, so passes can check it
+ * without comparing strings.
+ */
+typedef enum {
+  ENTITY_USER,
+  ENTITY_VILLAIN,
+  ENTITY_BULLET,
+  ENTITY_STEADY_PLATFORM,
+  ENTITY_MOVING_PLATFORM,
+  ENTITY_BREAKING_PLATFORM,
+  ENTITY_BROKEN_PLATFORM,
+  NUM_ENTITY_KINDS
+} entity_kind_t;
+
+/**
+ * Categories that group entity kinds, combined as a bitmask.
+ */
+typedef enum {
+  CATEGORY_PLAYER = 1 << 0,
+  CATEGORY_ENEMY = 1 << 1,
+  CATEGORY_PROJECTILE = 1 << 2,
+  CATEGORY_PLATFORM = 1 << 3,
+  /** Platforms the user bounces off */
+  CATEGORY_LANDABLE = 1 << 4,
+} entity_category_t;
+
+/**
+ * The info attached to every body of a kind.
+ * There is one shared, constant entity_info_t per kind.
+ */
+typedef struct {
+  entity_kind_t kind;
+  uint32_t categories;
+  const char *name;
+} entity_info_t;
+
+/**
+ * Returns the info to pass to body_init_with_info() for a kind.
+ *
+ * @param kind the kind of body being made
+ * @return the shared info for that kind
+ */
+void *entity_info(entity_kind_t kind);
+
+/**
+ * Returns a body's kind.
+ *
+ * @param body a body made with entity_info() as its info
+ * @return the body's kind
+ */
+entity_kind_t entity_get_kind(body_t *body);
+
+/**
+ * Checks whether a body belongs to any of the given categories.
+ * Bodies without entity info belong to none.
+ *
+ * @param body the body to check
+ * @param categories a bitmask of entity_category_t values
+ * @return whether the body's kind is in one of the categories
+ */
+bool entity_in_category(body_t *body, uint32_t categories);
+
+/**
+ * A stable reference to a body added with entity_add().
+ * A handle stays valid until its body is removed; after that,
+ * entity_get_body() returns NULL for it even if the slot is reused.
+ */
+typedef struct {
+  uint32_t index;
+  uint32_t generation;
+} entity_handle_t;
+
+/**
+ * A handle that refers to no body, for references that aren't set yet.
+ * entity_get_body() returns NULL for it.
+ */
+extern const entity_handle_t ENTITY_NO_HANDLE;
+
+/**
+ * Creates the empty slot table and the list of bodies for each kind.
+ */
+void entity_lists_init(void);
+
+/**
+ * Frees the slot table and kind lists. The bodies themselves belong to the
+ * scene.
+ */
+void entity_lists_free(void);
+
+/**
+ * Adds a body to the scene and to the list for its kind.
+ *
+ * @param scene the scene to add the body to
+ * @param body a body made with entity_info() as its info
+ * @return a handle to the body
+ */
+entity_handle_t entity_add(scene_t *scene, body_t *body);
+
+/**
+ * Adds a body that is already in the scene to the list for its kind.
+ * Pools use this to bring back a body they parked with entity_untrack().
+ *
+ * @param body a body made with entity_info() as its info
+ * @return a handle to the body
+ */
+entity_handle_t entity_track(body_t *body);
+
+/**
+ * Removes a body from the list for its kind but leaves it in the scene,
+ * so a pool can reuse it. Handles to the body become stale.
+ *
+ * @param body a body added with entity_add() or entity_track()
+ */
+void entity_untrack(body_t *body);
+
+/**
+ * Returns the body a handle refers to.
+ *
+ * @param handle a handle returned by entity_add(), or ENTITY_NO_HANDLE
+ * @return the body, or NULL if it has been removed
+ */
+body_t *entity_get_body(entity_handle_t handle);
+
+/**
+ * Removes a body in O(1): swaps it out of the list for its kind
+ * and marks it with body_remove(), so the next scene_tick() frees it
+ * along with every other removed body.
+ *
+ * @param body the body to remove
+ */
+void entity_remove(body_t *body);
+
+/**
+ * Returns the number of bodies of a kind that have not been removed.
+ *
+ * @param kind the kind of bodies to count
+ * @return the number of bodies of that kind
+ */
+size_t entity_count(entity_kind_t kind);
+
+/**
+ * Returns a body of one kind. Removing a body moves the last body of its
+ * kind into its place, so loops that remove should run from the end.
+ *
+ * @param kind the kind of body
+ * @param i the position in the kind's list, less than entity_count(kind)
+ * @return the body
+ */
+body_t *entity_get(entity_kind_t kind, size_t i);
+
+#endif // #ifndef __ENTITY_H__
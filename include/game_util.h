@@ -12,19 +12,13 @@
 #include "sdl_wrapper.h"
 
 /**
- * Returns the body of a platform.
+ * Moves the camera up when user passes a certain height above the bottom of
+ * the view. Bodies keep their world positions; only the camera and the
+ * villain, which hovers at a fixed height on screen, move.
  *
- * @param scene the scene of the game
- * @param body the body
- * @return the index of the body
- */
-ssize_t body_index_in_scene(scene_t *scene, body_t *body);
-
-/**
- * Moves screen down when user reaches certain threshold
- *
- * @param scene the scene of the game
  * @param user the user body
+ * @param villain the villain body, or NULL if it has not spawned
+ * @param camera the world position of the bottom left corner of the view
  * @return void
  */
-void screen_move(body_t *user, scene_t *scene);
+void screen_move(body_t *user, body_t *villain, vector_t *camera);
@@ -1,6 +1,7 @@
 #ifndef __LIST_H__
 #define __LIST_H__
 
+#include <stdbool.h>
 #include <stddef.h>
 
 /**
@@ -16,6 +17,13 @@ typedef struct list list_t;
  */
 typedef void (*free_func_t)(void *);
 
+/**
+ * A function that decides whether list_remove_if() removes an element.
+ * Its first argument is the element and its second is the auxiliary value
+ * passed to list_remove_if().
+ */
+typedef bool (*list_predicate_t)(void *, void *);
+
 /**
  * Allocates memory for a new list with space for the given number of elements.
  * The list is initially empty.
@@ -76,4 +84,46 @@ void list_add(list_t *list, void *value);
  */
 void *list_remove(list_t *list, size_t index);
 
+/**
+ * Removes the element at a given index in a list and returns it in O(1),
+ * by moving the last element into its place.
+ * The order of the other elements is not kept.
+ * Asserts that the index is valid, given the list's current size.
+ *
+ * @param list a pointer to a list returned from list_init()
+ * @param index an index in the list
+ * @return the element at the given index in the list
+ */
+void *list_swap_remove(list_t *list, size_t index);
+
+/**
+ * Removes every element a predicate is true of, in one pass over the list.
+ * The remaining elements keep their order.
+ * Removed elements are passed to the list's freer, if it has one.
+ * The predicate is called once on each element, in order.
+ *
+ * @param list a pointer to a list returned from list_init()
+ * @param predicate returns whether to remove an element
+ * @param aux an auxiliary value passed to the predicate
+ * @return the number of elements removed
+ */
+size_t list_remove_if(list_t *list, list_predicate_t predicate, void *aux);
+
+/**
+ * Removes every element from a list, keeping its capacity.
+ * The elements are passed to the list's freer, if it has one.
+ *
+ * @param list a pointer to a list returned from list_init()
+ */
+void list_clear(list_t *list);
+
+/**
+ * Makes sure a list can hold a number of elements without resizing.
+ * Asserts that the resize succeeded.
+ *
+ * @param list a pointer to a list returned from list_init()
+ * @param capacity the number of elements to make room for
+ */
+void list_reserve(list_t *list, size_t capacity);
+
 #endif // #ifndef __LIST_H__
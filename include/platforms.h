@@ -7,25 +7,162 @@
 
 #include "asset.h"
 #include "asset_cache.h"
+#include "entity.h"
 #include "sdl_wrapper.h"
 
+/**
+ * The platforms in the scene, ordered by the height of their top edges.
+ * Platforms only ever move sideways, so the order is kept by inserting each
+ * platform in place once, and the lowest platforms are always removed first.
+ */
+typedef struct platform_index platform_index_t;
+
+/**
+ * Allocates an empty platform index.
+ *
+ * @param initial_capacity the number of platforms to allocate space for
+ * @return the new index
+ */
+platform_index_t *platform_index_init(size_t initial_capacity);
+
+/**
+ * Frees a platform index. The platforms themselves belong to the scene.
+ *
+ * @param index the index to free
+ */
+void platform_index_free(platform_index_t *index);
+
+/**
+ * Returns the number of platforms in the index.
+ *
+ * @param index the platform index
+ * @return the number of platforms
+ */
+size_t platform_index_size(platform_index_t *index);
+
+/**
+ * Returns the platform at a position in the index.
+ *
+ * @param index the platform index
+ * @param i the position, where 0 is the lowest platform
+ * @return the platform
+ */
+body_t *platform_index_get(platform_index_t *index, size_t i);
+
+/**
+ * Returns the height of a platform's top edge.
+ *
+ * @param index the platform index
+ * @param i the position, where 0 is the lowest platform
+ * @return the top edge's y coordinate
+ */
+double platform_index_top(platform_index_t *index, size_t i);
+
+/**
+ * Removes the platform at a position in the index.
+ *
+ * @param index the platform index
+ * @param i the position, where 0 is the lowest platform
+ */
+void platform_index_remove(platform_index_t *index, size_t i);
+
+/**
+ * Inserts a platform in order of its top edge. Runs a binary search
+ * and moves the platforms above it up by one.
+ *
+ * @param index the platform index
+ * @param platform the platform to insert
+ */
+void platform_index_add(platform_index_t *index, body_t *platform);
+
+/**
+ * Returns the position of the lowest platform whose top edge is at or above
+ * a height, or the size of the index if there is none. O(log n).
+ *
+ * @param index the platform index
+ * @param top_y the height to search for
+ * @return the position of the first platform with top edge >= top_y
+ */
+size_t platform_index_lower_bound(platform_index_t *index, double top_y);
+
+/**
+ * Removes the lowest platforms from the index.
+ *
+ * @param index the platform index
+ * @param count the number of platforms to remove
+ */
+void platform_index_remove_lowest(platform_index_t *index, size_t count);
+
+/**
+ * Counts of the platform pool's work, to check that the steady-state game
+ * makes no new platforms.
+ */
+typedef struct {
+  /** Platforms made with make_platform(), each with a new image asset */
+  size_t created;
+  /** Platforms handed out again after being released */
+  size_t reused;
+  /** Platforms currently handed out */
+  size_t live;
+} platform_pool_stats_t;
+
+/**
+ * Sets up an empty platform pool for a scene. Each platform kind can have as
+ * many bodies as fit in a full screen of platforms, made the first time they
+ * are needed.
+ *
+ * @param scene the scene the pool's platforms are added to
+ */
+void platform_pool_init(scene_t *scene);
+
+/**
+ * Frees the pool's bookkeeping. The platforms themselves belong to the scene.
+ */
+void platform_pool_free(void);
+
+/**
+ * Hands out a platform of a kind at a position, with zero velocity.
+ * A released platform of the same kind is moved into place if there is one;
+ * otherwise a new platform and its image are made.
+ *
+ * @param kind the kind of platform
+ * @param center where to put the platform's center
+ * @return the platform, tracked in its kind's entity list
+ */
+body_t *platform_pool_acquire(entity_kind_t kind, vector_t center);
+
+/**
+ * Returns a platform to the pool. It stays in the scene with its image,
+ * parked far below the view, and leaves its kind's entity list.
+ *
+ * @param platform a platform from platform_pool_acquire()
+ */
+void platform_pool_release(body_t *platform);
+
+/**
+ * Returns the pool's counters.
+ *
+ * @return the number of platforms created, reused and live
+ */
+platform_pool_stats_t platform_pool_get_stats(void);
+
 /**
  * Returns the body of a platform.
  *
  * @param w width of platform
  * @param h height of platform
  * @param center vector coordinate of center of platform
- * @param platform_info what type of platform - steady, moving, breaking
+ * @param kind what type of platform - steady, moving, breaking
  * @return body_t of the platform
  */
-body_t *make_platform(size_t w, size_t h, vector_t center, const char *platform_info);
+body_t *make_platform(size_t w, size_t h, vector_t center, entity_kind_t kind);
 
 /**
- * Returns the info of a platform. Selects platform info between steady, moving, and breaking
+ * Returns the kind of a platform. Selects platform kind between steady, moving, and breaking
  *
- * @return the info of the platform
+ * @return the kind of the platform
  */
- const char *platform_select();
+entity_kind_t platform_select();
 
 /**
  * Creates initial platforms when the game starts.
@@ -33,28 +170,29 @@ body_t *make_platform(size_t w, size_t h, vector_t center, const char *platform_
  * @param state the state 
  * @return void
  */
-void platforms_init(list_t *platforms_list, scene_t *scene);
+void platforms_init(platform_index_t *platforms, scene_t *scene);
 
 /**
  * Creates platforms to replace the platforms that go off the bottom of the screen when the screen moves.
  *
  * @param state the state 
+ * @param camera_y the world height of the bottom of the view
  * @return void
  */
-void screen_move_platforms_create(list_t *platforms_list, scene_t *scene, int16_t score);
+void screen_move_platforms_create(platform_index_t *platforms, scene_t *scene, int16_t score, double camera_y);
 
 /**
  * Removes platforms that leave the screen when the screen moves up.
  *
  * @param state the state 
+ * @param camera_y the world height of the bottom of the view
  * @return void
  */
-void remove_platform(list_t *platforms_list, scene_t *scene);
+void remove_platform(platform_index_t *platforms, scene_t *scene, double camera_y);
 
 /**
- * Bounces the platforms off the sides of the screen when they reach them.
+ * Bounces the moving platforms off the sides of the screen when they reach them.
  *
- * @param state the state 
  * @return void
  */
-void platforms_bounce_off_wall(scene_t *scene);
+void platforms_bounce_off_wall(void);
@@ -11,14 +11,6 @@
 #include "game_util.h"
 #include "constants.h"
 
-/**
- * Starting dot used to calulate the distance traveled for the score
- *
- * @param center center/ where the dot is
- * @return body_t of the starting dot
- */
-body_t *start_dot(vector_t center);
-
 /**
  * make the doodler body
  *
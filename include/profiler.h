@@ -0,0 +1,100 @@
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * A zone that has begun but not yet ended.
+ * Made by profiler_zone_begin(); usually through PROFILE_ZONE().
+ */
+typedef struct {
+  const char *name;
+  uint64_t start_ns;
+} profile_zone_t;
+
+/**
+ * PROFILE_ZONE(name) times the rest of the enclosing block as a zone,
+ * ending it however the block is left.
+ * Zones are only recorded when built with -DPROFILE ('make profile');
+ * otherwise the macro expands to nothing.
+ * name must be a string literal, or another string that outlives the
+ * profiler.
+ */
+#ifdef PROFILE
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_ZONE(name)                                                     \
+  profile_zone_t PROFILE_CONCAT(profile_zone_, __LINE__)                       \
+      __attribute__((cleanup(profiler_zone_end))) = profiler_zone_begin(name)
+#else
+#define PROFILE_ZONE(name)                                                     \
+  do {                                                                         \
+  } while (0)
+#endif
+
+/**
+ * Allocates space for recorded zones. Zones that end after the space is
+ * full are dropped and counted.
+ *
+ * @param max_zones the most zones to record
+ */
+void profiler_init(size_t max_zones);
+
+/**
+ * Frees the recorded zones.
+ */
+void profiler_free(void);
+
+/**
+ * Returns whether profiler_init() has been called.
+ * Zones that end while the profiler is off are ignored.
+ *
+ * @return whether zones are being recorded
+ */
+bool profiler_enabled(void);
+
+/**
+ * Starts timing a zone.
+ *
+ * @param name the zone's name
+ * @return the zone, to pass to profiler_zone_end()
+ */
+profile_zone_t profiler_zone_begin(const char *name);
+
+/**
+ * Stops timing a zone and records it.
+ * Takes a pointer so it can be a cleanup function.
+ *
+ * @param zone the zone from profiler_zone_begin()
+ */
+void profiler_zone_end(profile_zone_t *zone);
+
+/**
+ * Returns the number of zones recorded so far.
+ *
+ * @return the number of zones
+ */
+size_t profiler_zone_count(void);
+
+/**
+ * Writes the recorded zones as Chrome trace event JSON,
+ * which chrome://tracing and https://ui.perfetto.dev can open.
+ *
+ * @param path the file to write
+ * @return whether the file was written
+ */
+bool profiler_write_trace(const char *path);
+
+/**
+ * Writes a table with one line per zone name: how many times it ran,
+ * its total time, and the mean, 50th, 90th and 99th percentile and
+ * longest durations in microseconds.
+ *
+ * @param out the stream to write to
+ */
+void profiler_write_summary(FILE *out);
+
+#endif // #ifndef __PROFILER_H__
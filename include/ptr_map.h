@@ -0,0 +1,65 @@
+#ifndef __PTR_MAP_H__
+#define __PTR_MAP_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * A hash map keyed by pointer identity, using open addressing with linear
+ * probing. Lookups, insertions and deletions are O(1) on average and
+ * deletions leave no tombstones behind.
+ */
+typedef struct ptr_map ptr_map_t;
+
+/**
+ * Allocates an empty map.
+ *
+ * @param initial_capacity the number of keys to allocate space for
+ * @return the new map
+ */
+ptr_map_t *ptr_map_init(size_t initial_capacity);
+
+/**
+ * Frees a map. The keys and values are not freed.
+ *
+ * @param map the map to free
+ */
+void ptr_map_free(ptr_map_t *map);
+
+/**
+ * Returns the number of keys in a map.
+ *
+ * @param map the map
+ * @return the number of keys
+ */
+size_t ptr_map_size(ptr_map_t *map);
+
+/**
+ * Looks up a key.
+ *
+ * @param map the map
+ * @param key a non-NULL key
+ * @param value set to the key's value if it is found; may be NULL
+ * @return whether the key is in the map
+ */
+bool ptr_map_get(ptr_map_t *map, const void *key, void **value);
+
+/**
+ * Sets a key's value, adding the key if it is not in the map.
+ *
+ * @param map the map
+ * @param key a non-NULL key
+ * @param value the value to store
+ */
+void ptr_map_put(ptr_map_t *map, const void *key, void *value);
+
+/**
+ * Removes a key if it is in the map.
+ *
+ * @param map the map
+ * @param key the key to remove
+ * @return whether the key was in the map
+ */
+bool ptr_map_remove(ptr_map_t *map, const void *key);
+
+#endif // #ifndef __PTR_MAP_H__
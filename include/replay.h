@@ -0,0 +1,91 @@
+#ifndef __REPLAY_H__
+#define __REPLAY_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "sdl_wrapper.h"
+
+/**
+ * Records the nondeterministic inputs of a session to a compact binary file:
+ * the srand() seed, every key event delivered by sdl_is_done() with its frame
+ * number, and every frame time handed out by time_since_last_tick().
+ * Playing the file back reproduces the session exactly.
+ */
+
+/**
+ * Starts writing a recording to the given path.
+ * The file is finished automatically when the program exits.
+ * Exits with an error message if the file cannot be created.
+ *
+ * @param path the file to write
+ * @param seed the seed passed to srand() for this session
+ */
+void replay_start_recording(const char *path, unsigned int seed);
+
+/**
+ * Loads a recording so that its inputs replace the live ones.
+ * Exits with an error message if the file is missing or malformed.
+ *
+ * @param path the file to read
+ * @return the srand() seed the recording was made with
+ */
+unsigned int replay_load(const char *path);
+
+/**
+ * Returns whether a loaded recording still has frames left to play.
+ *
+ * @return true while recorded inputs are being played back
+ */
+bool replay_is_playing(void);
+
+/**
+ * Returns the number of frames in the loaded recording.
+ *
+ * @return the frame count, or 0 if nothing is loaded
+ */
+size_t replay_frames(void);
+
+/**
+ * Appends a key event to the recording, if one is being made.
+ *
+ * @param key the key passed to the key handler
+ * @param type the type of key event
+ * @param held_time the time the key has been held in seconds
+ */
+void replay_record_key(char key, key_event_type_t type, double held_time);
+
+/**
+ * Appends a frame time to the recording, if one is being made.
+ *
+ * @param dt the number of seconds returned by time_since_last_tick()
+ */
+void replay_record_tick(double dt);
+
+/**
+ * Returns the next recorded frame time.
+ * Asserts that a recording is playing.
+ *
+ * @return the number of seconds the recorded frame took
+ */
+double replay_next_tick(void);
+
+/**
+ * Passes every recorded key event of the current frame to handler.
+ *
+ * @param handler the key handler registered with sdl_on_key()
+ * @param state the state to pass to the handler
+ */
+void replay_play_keys(key_handler_t handler, void *state);
+
+/**
+ * Marks the end of a frame. Called once per sdl_is_done().
+ */
+void replay_end_frame(void);
+
+/**
+ * Finishes the recording, if one is being made, and closes its file.
+ */
+void replay_stop(void);
+
+#endif // #ifndef __REPLAY_H__
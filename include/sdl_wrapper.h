@@ -43,8 +43,49 @@ typedef void (*key_handler_t)(char key, key_event_type_t type, double held_time,
                               void *state);
 
 /**
- * Initializes the SDL window and renderer.
+ * A source of frame times for time_since_last_tick().
+ * Each call returns the number of seconds since the previous call.
+ */
+typedef double (*tick_source_t)(void);
+
+/**
+ * Counts of the work the wrapper has been asked to do since sdl_init().
+ * In a HEADLESS build the drawing and audio calls only bump these counters,
+ * so a simulation run can still report how much it would have rendered.
+ */
+typedef struct {
+  /** Calls to sdl_show() */
+  size_t presents;
+  /**
+   * Geometry submissions, texture copies and lines sent to the renderer,
+   * or that would have been in a HEADLESS build
+   */
+  size_t draw_calls;
+  /** Bodies passed to sdl_draw_body() */
+  size_t bodies_drawn;
+  /** Images passed to sdl_render_image() */
+  size_t images_rendered;
+  /** Calls to sdl_render_text() or sdl_render_text_region() */
+  size_t texts_rendered;
+  /** Calls to SDL_play_sound() and SDL_play_music() */
+  size_t sounds_played;
+} sdl_stats_t;
+
+/**
+ * The affine map from scene coordinates to window pixels:
+ * pixel.x = offset_x + scale * x and pixel.y = offset_y - scale * y.
+ * The y axis is flipped because positive y is down on the screen.
+ */
+typedef struct {
+  double scale;
+  double offset_x;
+  double offset_y;
+} view_transform_t;
+
+/**
+ * Initializes the SDL window and renderer, along with SDL_ttf and SDL_mixer.
  * Must be called once before any of the other SDL functions.
+ * In a HEADLESS build no window is opened and only the scene bounds are kept.
  *
  * @param min the x and y coordinates of the bottom left of the scene
  * @param max the x and y coordinates of the top right of the scene
@@ -65,7 +106,9 @@ bool sdl_is_done(state_t *state);
 void sdl_clear(void);
 
 /**
- * Draws a body using the color of the body.
+ * Queues a body to be drawn using the color of the body.
+ * Queued bodies are batched into one vertex buffer and submitted together
+ * by sdl_render_scene() or sdl_show().
  *
  * @param body the body struct to draw
  */
@@ -90,6 +133,18 @@ SDL_Texture *sdl_get_image_texture(const char *image_path);
  */
 SDL_Rect *sdl_get_rect(double x, double y, double w, double h);
 
+/**
+ * Creates an SDL_Rect in the frame arena.
+ * It must not be freed, and is only valid until the end of the frame.
+ *
+ * @param x the x-coordinate of the rectangle
+ * @param y the y-coordinate of the rectangle
+ * @param w the width of the rectangle
+ * @param h the height of the rectangle
+ * @return a pointer to the created rectangle
+ */
+SDL_Rect *sdl_get_frame_rect(double x, double y, double w, double h);
+
 /**
  * Renders an image to the screen using the specified texture and rectangle.
  *
@@ -102,13 +157,15 @@ void sdl_render_image(SDL_Texture *image_texture, SDL_Rect *rect);
 /**
  * Displays the rendered frame on the SDL window.
  * Must be called after drawing the bodies in order to show them.
+ * Should be called once per frame; it also closes the frame's counters.
  */
 void sdl_show(void);
 
 /**
- * Draws all bodies in a scene.
- * This internally calls sdl_clear(), sdl_draw_body(), and sdl_show(),
- * so those functions should not be called directly.
+ * Draws all bodies in a scene that the camera can see.
+ * This internally calls sdl_clear() and sdl_draw_body(), then submits every
+ * body with a single geometry call. It does not present the frame,
+ * so images can still be drawn on top before sdl_show().
  *
  * @param scene the scene to draw
  */
@@ -144,14 +201,76 @@ void sdl_on_key(key_handler_t handler);
 
 /**
  * Gets the amount of time that has passed since the last time
- * this function was called, in seconds.
+ * this function was called, in seconds, according to the current tick source.
  *
  * @return the number of seconds that have elapsed
  */
 double time_since_last_tick(void);
 
+/**
+ * Replaces the time source used by time_since_last_tick().
+ * Defaults to sdl_monotonic_tick(), or sdl_fixed_tick() in a HEADLESS build.
+ *
+ * @param source the function to ask for frame times
+ */
+void sdl_set_tick_source(tick_source_t source);
+
+/**
+ * Measures wall time with SDL's high resolution performance counter.
+ * Unlike clock(), this does not depend on how busy the CPU is.
+ * Returns 0 the first time it is called.
+ *
+ * @return the number of seconds since the previous call
+ */
+double sdl_monotonic_tick(void);
+
+/**
+ * Reports the same frame time on every call, 1/60 of a second,
+ * so that simulations advance identically from run to run.
+ *
+ * @return the fixed frame time in seconds
+ */
+double sdl_fixed_tick(void);
+
 void sdl_render_text(SDL_Surface *surfacemssage, SDL_Rect *rect);
 
+/**
+ * Opens a font at the given size. Returns NULL in a HEADLESS build.
+ * Use asset_cache_font_get_or_create() to share fonts instead.
+ *
+ * @param font_path the file path of the .ttf font
+ * @param font_size the point size to open the font at
+ * @return the opened font
+ */
+TTF_Font *sdl_get_font(const char *font_path, size_t font_size);
+
+/**
+ * Rasterizes a string in black and uploads it as a texture.
+ * The caller owns the texture. Returns NULL in a HEADLESS build.
+ *
+ * @param font the font to render with
+ * @param text the string to render
+ * @return the texture holding the string
+ */
+SDL_Texture *sdl_get_text_texture(TTF_Font *font, const char *text);
+
+/**
+ * Copies part of a text texture to the screen.
+ *
+ * @param texture the texture returned by sdl_get_text_texture()
+ * @param src the region of the texture to copy, or NULL for all of it
+ * @param dst the rectangle to stretch the region over
+ */
+void sdl_render_text_region(SDL_Texture *texture, SDL_Rect *src,
+                            SDL_Rect *dst);
+
+/**
+ * Returns the window rectangle covered by a body's cached bounding box.
+ * Used to place a body's sprite.
+ *
+ * @param body the body
+ * @return the rectangle, in pixels
+ */
 SDL_Rect sdl_get_body_bounding_box(body_t *body);
 
 /**
@@ -163,9 +282,64 @@ void SDL_play_music(const char *path);
 
 /**
  * Plays selected sound effect of sound path;
+ * The WAV file is decoded once by the sound bank and played from memory.
  * 
  * @param path the file path of the selected WAV file;
  */
 void SDL_play_sound(const char *path);
 
+/**
+ * Returns the current view transform.
+ * It is only recomputed when sdl_is_done() sees the window being resized.
+ *
+ * @return a copy of the view transform
+ */
+view_transform_t sdl_get_view(void);
+
+/**
+ * Moves the camera so that the bottom left corner of the view shows the given
+ * world position. Bodies keep their world positions; only the view's offset
+ * changes, so this takes constant time.
+ *
+ * @param position the world position of the bottom left corner of the view
+ */
+void sdl_set_camera(vector_t position);
+
+/**
+ * Returns whether a body's cached bounding box overlaps the area the camera
+ * shows. Used to cull offscreen bodies.
+ *
+ * @param body the body to test
+ * @return false if the body is certainly offscreen
+ */
+bool sdl_body_visible(body_t *body);
+
+/**
+ * Maps an array of scene coordinates to window pixels, rounded to the nearest
+ * pixel. The loops have no branches, so they vectorize on optimized builds.
+ * pixels may be the same array as points.
+ *
+ * @param view the view transform to apply
+ * @param points the scene coordinates
+ * @param pixels the array to write the window coordinates to
+ * @param n the number of points
+ */
+void view_project_points(const view_transform_t *view, const vector_t *points,
+                         vector_t *pixels, size_t n);
+
+/**
+ * Returns the render and audio counters accumulated since sdl_init().
+ *
+ * @return a copy of the counters
+ */
+sdl_stats_t sdl_get_stats(void);
+
+/**
+ * Returns the counters of the last frame closed by sdl_show(),
+ * e.g. its draw calls and presents.
+ *
+ * @return a copy of the last frame's counters
+ */
+sdl_stats_t sdl_get_frame_stats(void);
+
 #endif // #ifndef __SDL_WRAPPER_H__
\ No newline at end of file
@@ -0,0 +1,79 @@
+#ifndef __SHAPE_TEMPLATE_H__
+#define __SHAPE_TEMPLATE_H__
+
+#include <stddef.h>
+
+#include "list.h"
+#include "vector.h"
+
+/**
+ * The vertices of a polygon around its centroid, computed once and shared
+ * by every body of that shape. Templates live until the program exits.
+ */
+typedef struct shape_template shape_template_t;
+
+/**
+ * Returns the template for a polygon approximating an ellipse,
+ * making it the first time it is asked for.
+ * The first vertex is on the positive x axis and they go counterclockwise.
+ *
+ * @param x_radius the radius along the x axis
+ * @param y_radius the radius along the y axis
+ * @param num_points the number of vertices
+ * @return the shared template
+ */
+const shape_template_t *shape_template_ellipse(double x_radius, double y_radius,
+                                               size_t num_points);
+
+/**
+ * Returns the template for a polygon approximating a circle.
+ * Acts like shape_template_ellipse() with equal radii.
+ *
+ * @param radius the radius of the circle
+ * @param num_points the number of vertices
+ * @return the shared template
+ */
+const shape_template_t *shape_template_circle(double radius, size_t num_points);
+
+/**
+ * Returns the template for an axis-aligned rectangle,
+ * making it the first time it is asked for.
+ * The first vertex is the bottom left corner and they go counterclockwise.
+ *
+ * @param width the width of the rectangle
+ * @param height the height of the rectangle
+ * @return the shared template
+ */
+const shape_template_t *shape_template_rect(double width, double height);
+
+/**
+ * Returns the number of vertices in a template.
+ *
+ * @param template a template
+ * @return its number of vertices
+ */
+size_t shape_template_size(const shape_template_t *template);
+
+/**
+ * Returns a vertex of a template, relative to the centroid.
+ *
+ * @param template a template
+ * @param i the index of the vertex
+ * @return the vertex
+ */
+vector_t shape_template_vertex(const shape_template_t *template, size_t i);
+
+/**
+ * Makes a shape list for body_init() with the template's vertices around a
+ * center. The vertices share a single allocation, which is freed along with
+ * the list, so a new body costs no trig and one allocation for its vertices.
+ * The vertices must only be freed by list_free().
+ *
+ * @param template a template
+ * @param center where to put the shape's centroid
+ * @return a list of the shape's vertices
+ */
+list_t *shape_template_instantiate(const shape_template_t *template,
+                                   vector_t center);
+
+#endif // #ifndef __SHAPE_TEMPLATE_H__
@@ -0,0 +1,54 @@
+#ifndef __SIM_H__
+#define __SIM_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Options for a headless simulation run, read from the command line.
+ */
+typedef struct {
+  /** The number of frames to run emscripten_main() for */
+  size_t steps;
+  /** The seed passed to srand() in emscripten_init() */
+  unsigned int seed;
+  /** The file to record the session's inputs to, or NULL */
+  const char *record_path;
+  /** The recording to play back instead of live input, or NULL */
+  const char *replay_path;
+  /** The file to write a Chrome trace of the run's frames to, or NULL */
+  const char *trace_path;
+} sim_options_t;
+
+/**
+ * Parses the command line of a run and starts any recording or replay.
+ * Recognized flags are `--steps N`, `--seed S`, `--record FILE`,
+ * `--replay FILE` and `--trace FILE`.
+ * `--trace` only has an effect in builds with -DPROFILE.
+ * If no seed is given, the current time is used.
+ * A replay supplies its own seed, and its frame count if `--steps` is absent.
+ * Exits with a usage message on an unknown flag.
+ *
+ * @param argc the number of arguments
+ * @param argv the arguments, including the program name
+ * @return the parsed options
+ */
+sim_options_t sim_parse_args(int argc, char *argv[]);
+
+/**
+ * Fixes the seed that sim_get_seed() returns.
+ *
+ * @param seed the seed to use for the random platform layout
+ */
+void sim_set_seed(unsigned int seed);
+
+/**
+ * Returns the seed for the game's random number generator.
+ * If no seed has been set, picks one from the current time and keeps it,
+ * so later calls return the same value.
+ *
+ * @return the seed to pass to srand()
+ */
+unsigned int sim_get_seed(void);
+
+#endif // #ifndef __SIM_H__
@@ -0,0 +1,56 @@
+#ifndef __SOUND_BANK_H__
+#define __SOUND_BANK_H__
+
+#include <SDL2/SDL_mixer.h>
+#include <stddef.h>
+
+/**
+ * A handle to a sound effect decoded into memory by the sound bank.
+ */
+typedef size_t sound_t;
+
+/**
+ * Load and play counters for the sound bank.
+ */
+typedef struct {
+  /** WAV files read from disk and decoded */
+  size_t loads;
+  /** Sound effects started with sound_bank_play() */
+  size_t plays;
+} sound_bank_stats_t;
+
+/**
+ * Decodes every sound effect listed in SOUND_PATHS into memory.
+ * Must be called after the audio device has been opened.
+ */
+void sound_bank_init(void);
+
+/**
+ * Returns the handle for a sound effect, decoding the WAV file the first time
+ * a path is seen. Paths are matched by address first, then by contents.
+ *
+ * @param path the file path of the WAV file
+ * @return the handle of the decoded sound
+ */
+sound_t sound_bank_get(const char *path);
+
+/**
+ * Plays a decoded sound effect on the first free mixer channel.
+ *
+ * @param sound the handle returned by sound_bank_get()
+ */
+void sound_bank_play(sound_t sound);
+
+/**
+ * Returns the load and play counts since sound_bank_init().
+ *
+ * @return a copy of the counters
+ */
+sound_bank_stats_t sound_bank_get_stats(void);
+
+/**
+ * Frees every decoded sound.
+ */
+void sound_bank_free(void);
+
+#endif // #ifndef __SOUND_BANK_H__
@@ -0,0 +1,74 @@
+#ifndef __TEXT_H__
+#define __TEXT_H__
+
+#include <SDL2/SDL_ttf.h>
+#include <stddef.h>
+
+/**
+ * A string drawn in a fixed font whose texture is kept between frames.
+ * The string is only rasterized again when it changes.
+ */
+typedef struct text_label text_label_t;
+
+/**
+ * A set of characters rasterized once into a single texture,
+ * so any string made of them can be drawn as a row of textured quads.
+ */
+typedef struct glyph_atlas glyph_atlas_t;
+
+/**
+ * Allocates an empty label. The font comes from the asset cache.
+ *
+ * @param font_path the file path of the .ttf font
+ * @param font_size the point size of the font
+ * @return a pointer to the newly allocated label
+ */
+text_label_t *text_label_init(const char *font_path, size_t font_size);
+
+/**
+ * Draws text stretched over rect, rasterizing it only if it differs from
+ * the string drawn last time.
+ *
+ * @param label the label to draw
+ * @param text the string to draw
+ * @param rect the rectangle to stretch the text over
+ */
+void text_label_draw(text_label_t *label, const char *text, SDL_Rect *rect);
+
+/**
+ * Frees a label and its texture.
+ *
+ * @param label the label to free
+ */
+void text_label_free(text_label_t *label);
+
+/**
+ * Rasterizes the given characters into one texture and records where each
+ * one lies in it. Must be called after sdl_init().
+ *
+ * @param font_path the file path of the .ttf font
+ * @param font_size the point size of the font
+ * @param glyphs the 7-bit ASCII characters to include
+ * @return a pointer to the newly allocated atlas
+ */
+glyph_atlas_t *glyph_atlas_init(const char *font_path, size_t font_size,
+                                const char *glyphs);
+
+/**
+ * Draws text stretched over rect using one quad per character.
+ * Characters missing from the atlas are skipped.
+ *
+ * @param atlas the atlas holding the characters of text
+ * @param text the string to draw
+ * @param rect the rectangle to stretch the text over
+ */
+void glyph_atlas_draw(glyph_atlas_t *atlas, const char *text, SDL_Rect *rect);
+
+/**
+ * Frees an atlas and its texture.
+ *
+ * @param atlas the atlas to free
+ */
+void glyph_atlas_free(glyph_atlas_t *atlas);
+
+#endif // #ifndef __TEXT_H__
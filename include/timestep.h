@@ -0,0 +1,46 @@
+#ifndef __TIMESTEP_H__
+#define __TIMESTEP_H__
+
+#include <stddef.h>
+
+/**
+ * An accumulator that turns variable frame times into a whole number of
+ * fixed physics steps, so the simulation does not depend on render speed.
+ */
+typedef struct {
+  /** The length of one physics step in seconds */
+  double step;
+  /** The most steps a single frame may run, to avoid a spiral of death */
+  size_t max_substeps;
+  /** Frame time that has not been simulated yet */
+  double accumulator;
+} timestep_t;
+
+/**
+ * Creates an empty accumulator.
+ * Asserts that step is positive and max_substeps is nonzero.
+ *
+ * @param step the length of one physics step in seconds
+ * @param max_substeps the most steps to run for a single frame
+ * @return the new accumulator
+ */
+timestep_t timestep_init(double step, size_t max_substeps);
+
+/**
+ * Adds a frame's elapsed time and returns how many fixed steps to run.
+ * Time beyond max_substeps steps is dropped rather than carried over.
+ *
+ * @param timestep the accumulator
+ * @param dt the seconds elapsed since the previous frame
+ * @return the number of steps of length timestep->step to simulate
+ */
+size_t timestep_advance(timestep_t *timestep, double dt);
+
+/**
+ * Discards any accumulated time, e.g. after the game is reset.
+ *
+ * @param timestep the accumulator
+ */
+void timestep_reset(timestep_t *timestep);
+
+#endif // #ifndef __TIMESTEP_H__
@@ -0,0 +1,120 @@
+#ifndef __VEC_ARRAY_H__
+#define __VEC_ARRAY_H__
+
+#include <stddef.h>
+
+#include "list.h"
+#include "vector.h"
+
+/**
+ * A growable array of vectors, stored by value in one contiguous block.
+ * Unlike a list_t of vector_t *, adding a vector doesn't allocate it
+ * separately, and vec_array_data() can be handed to the vec_batch.h loops.
+ * Pointers into the array are invalidated by anything that grows it.
+ */
+typedef struct vec_array vec_array_t;
+
+/**
+ * Allocates an empty array.
+ *
+ * @param initial_capacity the number of vectors to allocate space for
+ * @return the new array
+ */
+vec_array_t *vec_array_init(size_t initial_capacity);
+
+/**
+ * Frees an array.
+ *
+ * @param array the array to free
+ */
+void vec_array_free(vec_array_t *array);
+
+/**
+ * Returns the number of vectors in an array.
+ *
+ * @param array the array
+ * @return the number of vectors
+ */
+size_t vec_array_size(const vec_array_t *array);
+
+/**
+ * Returns the array's vectors, contiguous from index 0 to size - 1.
+ *
+ * @param array the array
+ * @return the vectors, valid until the array next grows or is freed
+ */
+vector_t *vec_array_data(vec_array_t *array);
+
+/**
+ * Returns the vector at an index.
+ * Asserts that the index is valid.
+ *
+ * @param array the array
+ * @param index the index
+ * @return the vector
+ */
+vector_t vec_array_get(const vec_array_t *array, size_t index);
+
+/**
+ * Replaces the vector at an index.
+ * Asserts that the index is valid.
+ *
+ * @param array the array
+ * @param index the index
+ * @param value the new vector
+ */
+void vec_array_set(vec_array_t *array, size_t index, vector_t value);
+
+/**
+ * Appends a vector, growing the array if it is full.
+ *
+ * @param array the array
+ * @param value the vector to append
+ */
+void vec_array_add(vec_array_t *array, vector_t value);
+
+/**
+ * Appends a run of vectors, growing the array at most once.
+ * values must not point into the array itself.
+ *
+ * @param array the array
+ * @param values the vectors to append
+ * @param n the number of vectors
+ */
+void vec_array_append(vec_array_t *array, const vector_t *values, size_t n);
+
+/**
+ * Appends the vectors of a list of vector_t *, growing the array at most once.
+ *
+ * @param array the array
+ * @param list a list of vector_t *, e.g. from body_get_shape()
+ */
+void vec_array_append_list(vec_array_t *array, list_t *list);
+
+/**
+ * Makes sure the array can hold a number of vectors without growing again.
+ *
+ * @param array the array
+ * @param capacity the number of vectors to make room for
+ */
+void vec_array_reserve(vec_array_t *array, size_t capacity);
+
+/**
+ * Removes every vector, keeping the array's capacity.
+ *
+ * @param array the array
+ */
+void vec_array_clear(vec_array_t *array);
+
+/**
+ * Removes the vector at an index in O(1) by moving the last vector into its
+ * place, so the order of the rest of the array is not kept.
+ * Asserts that the index is valid.
+ *
+ * @param array the array
+ * @param index the index of the vector to remove
+ * @return the removed vector
+ */
+vector_t vec_array_swap_remove(vec_array_t *array, size_t index);
+
+#endif // #ifndef __VEC_ARRAY_H__
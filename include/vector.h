@@ -1,6 +1,14 @@
 #ifndef __VECTOR_H__
 #define __VECTOR_H__
 
+#include <math.h>
+
+/**
+ * The vector operations are static inline, so they compile into their callers
+ * and loops over them can be vectorized. Loops over whole arrays of vectors
+ * are in vec_batch.h.
+ */
+
 /**
  * A real-valued 2-dimensional vector.
  * Positive x is towards the right; positive y is towards the top.
@@ -13,8 +21,8 @@ typedef struct {
 
 /**
  * The zero vector, i.e. (0, 0).
- * "extern" declares this global variable without allocating memory for it.
- * You will need to define "const vector_t VEC_ZERO = ..." in vector.c.
+ * "extern" declares this global variable without allocating memory for it;
+ * it is defined in vector.c.
  */
 extern const vector_t VEC_ZERO;
 
@@ -26,7 +34,9 @@ extern const vector_t VEC_ZERO;
  * @param v2 the second vector
  * @return v1 + v2
  */
-vector_t vec_add(vector_t v1, vector_t v2);
+static inline vector_t vec_add(vector_t v1, vector_t v2) {
+  return (vector_t){.x = v1.x + v2.x, .y = v1.y + v2.y};
+}
 
 /**
  * Subtracts two vectors.
@@ -36,7 +46,9 @@ vector_t vec_add(vector_t v1, vector_t v2);
  * @param v2 the second vector
  * @return v1 - v2
  */
-vector_t vec_subtract(vector_t v1, vector_t v2);
+static inline vector_t vec_subtract(vector_t v1, vector_t v2) {
+  return (vector_t){.x = v1.x - v2.x, .y = v1.y - v2.y};
+}
 
 /**
  * Computes the additive inverse a vector.
@@ -45,7 +57,9 @@ vector_t vec_subtract(vector_t v1, vector_t v2);
  * @param v the vector whose inverse to compute
  * @return -v
  */
-vector_t vec_negate(vector_t v);
+static inline vector_t vec_negate(vector_t v) {
+  return (vector_t){.x = -v.x, .y = -v.y};
+}
 
 /**
  * Multiplies a vector by a scalar.
@@ -55,7 +69,9 @@ vector_t vec_negate(vector_t v);
  * @param v the vector to scale
  * @return scalar * v
  */
-vector_t vec_multiply(double scalar, vector_t v);
+static inline vector_t vec_multiply(double scalar, vector_t v) {
+  return (vector_t){.x = scalar * v.x, .y = scalar * v.y};
+}
 
 /**
  * Computes the dot product of two vectors.
@@ -65,7 +81,9 @@ vector_t vec_multiply(double scalar, vector_t v);
  * @param v2 the second vector
  * @return v1 . v2
  */
-double vec_dot(vector_t v1, vector_t v2);
+static inline double vec_dot(vector_t v1, vector_t v2) {
+  return v1.x * v2.x + v1.y * v2.y;
+}
 
 /**
  * Computes the cross product of two vectors,
@@ -76,7 +94,9 @@ double vec_dot(vector_t v1, vector_t v2);
  * @param v2 the second vector
  * @return the z-component of v1 x v2
  */
-double vec_cross(vector_t v1, vector_t v2);
+static inline double vec_cross(vector_t v1, vector_t v2) {
+  return v1.x * v2.y - v1.y * v2.x;
+}
 
 /**
  * Rotates a vector by an angle around (0, 0).
@@ -90,7 +110,11 @@ double vec_cross(vector_t v1, vector_t v2);
  * @param angle the angle to rotate the vector
  * @return v rotated by the given angle
  */
-vector_t vec_rotate(vector_t v, double angle);
+static inline vector_t vec_rotate(vector_t v, double angle) {
+  double c = cos(angle);
+  double s = sin(angle);
+  return (vector_t){.x = v.x * c - v.y * s, .y = v.x * s + v.y * c};
+}
 
 /**
  * Calculate the length of a vector.
@@ -98,6 +122,8 @@ vector_t vec_rotate(vector_t v, double angle);
  * @param v the vector to calculate the length of
  * @return a double representing the vector's magnitude
  */
-double vec_get_length(vector_t v);
+static inline double vec_get_length(vector_t v) {
+  return sqrt(vec_dot(v, v));
+}
 
 #endif // #ifndef __VECTOR_H__
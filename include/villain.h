@@ -14,11 +14,12 @@
 #include "forces.h"
 #include "sdl_wrapper.h"
 #include "constants.h"
+#include "entity.h"
 #include "scene.h"
 #include "state.h"
 
 /**
- * Creates the body for the villain inside of the scene with VILLAIN_INFO
+ * Creates the body for the villain inside of the scene with kind ENTITY_VILLAIN
  * 
  * @param radius the radius of the body of the villain
  * @param center the center of the body of the villain inside of the scene
@@ -31,9 +32,10 @@ body_t *make_villain(double radius, vector_t center);
  * with the asset of the villain image HAS TO BE CHANGED 
  * 
  * @param state the state of where we want to initalize the villain body.
- * @param villain a double pointer to the newley created villain body.
+ * @param villain set to a handle to the newley created villain body.
+ * @param camera_y the world height of the bottom of the view
  */
-void villain_init(scene_t *scene, body_t **villain);
+void villain_init(scene_t *scene, entity_handle_t *villain, double camera_y);
 
 /**
  * Initalizes a hover effect from left to right on the 
@@ -54,9 +56,62 @@ void villain_hover(body_t **villain);
 body_t *make_bullet(double radius, vector_t center);
 
 /**
- * Creates an asset to place on the bullet body and shoots
- * the bullet by creating a downward velocity relative to the 
- * score of the game.
+ * Counts of the bullet pool's work.
+ */
+typedef struct {
+  /** Bullets handed out by bullet_pool_acquire() */
+  size_t spawned;
+  /** Shots skipped because every bullet was live */
+  size_t dropped;
+  /** Bullets currently handed out */
+  size_t live;
+} bullet_pool_stats_t;
+
+/**
+ * Makes BULLET_POOL_CAPACITY bullets and their images up front and parks
+ * them in the scene, far below the view.
+ *
+ * @param scene the scene the bullets are added to
+ */
+void bullet_pool_init(scene_t *scene);
+
+/**
+ * Frees the pool's bookkeeping. The bullets themselves belong to the scene.
+ */
+void bullet_pool_free(void);
+
+/**
+ * Hands out a parked bullet at a position, with zero velocity.
+ * Live bullets are the ENTITY_BULLET entity list.
+ *
+ * @param center where to put the bullet's center
+ * @return the bullet, or NULL if every bullet is live
+ */
+body_t *bullet_pool_acquire(vector_t center);
+
+/**
+ * Returns a live bullet to the pool and parks it.
+ *
+ * @param bullet a bullet from bullet_pool_acquire()
+ */
+void bullet_pool_release(body_t *bullet);
+
+/**
+ * Returns every live bullet to the pool.
+ */
+void bullet_pool_release_all(void);
+
+/**
+ * Returns the pool's counters.
+ *
+ * @return the number of bullets spawned, shots dropped and live bullets
+ */
+bullet_pool_stats_t bullet_pool_get_stats(void);
+
+/**
+ * Takes a bullet from the pool and shoots it
+ * by creating a downward velocity relative to the
+ * score of the game. Does nothing if the pool is empty.
  * 
  * @param scene the scene of the game the bullet is in 
  * @param villain the villain of the game
@@ -66,13 +121,14 @@ body_t *make_bullet(double radius, vector_t center);
 void villain_shoot_bullet(scene_t *scene, body_t *villain, uint16_t score);
 
 /**
- * Scans the scene for any bullet bodies that have gone
- * outside of the bounds of the screen and remvoes them
- * from the scene
+ * Scans the live bullets for any that have gone
+ * outside of the bounds of the screen and returns them
+ * to the pool
  * 
  * @param scene the scene of the game
+ * @param camera_y the world height of the bottom of the view
  */
-void remove_offscreen_bullets(scene_t *scene);
+void remove_offscreen_bullets(scene_t *scene, double camera_y);
 
 /**
  * Scans the scene for a collision between any of the bullets
@@ -91,12 +147,14 @@ bool check_villain_bullet_collision(scene_t *scene, body_t *user);
  * time the function is called and utilizes the
  * neccessary helper fucntions on the villain.abort
  * 
- * @param villain a double pointer to the villain of the state
+ * @param villain a handle to the villain of the state, or ENTITY_NO_HANDLE
+ * before it spawns. Set when the villain spawns.
  * @param score the current score of the game
  * @param scene the scene of the game 
  * @param dt the rate at which the time of the game is changing
+ * @param camera_y the world height of the bottom of the view
  * 
  */
-void update_villain(body_t **villain, uint16_t score, scene_t *scene, double dt);
+void update_villain(entity_handle_t *villain, uint16_t score, scene_t *scene, double dt, double camera_y);
 
 #endif // __VILLAIN_H__
\ No newline at end of file
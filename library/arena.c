@@ -0,0 +1,146 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "arena.h"
+
+const size_t FRAME_ARENA_CAPACITY = 64 * 1024;
+const size_t ARENA_ALIGNMENT = _Alignof(max_align_t);
+
+/**
+ * Memory taken from the heap when the arena's block ran out.
+ * Freed by the next arena_reset().
+ */
+typedef struct chunk {
+  struct chunk *next;
+  size_t capacity;
+  size_t used;
+  max_align_t data[];
+} chunk_t;
+
+struct arena {
+  char *block;
+  size_t capacity;
+  size_t used;
+  /** The overflow chunks, newest first */
+  chunk_t *overflow;
+  /** The bytes handed out since the last reset, across the block and chunks */
+  size_t cycle_bytes;
+  arena_stats_t stats;
+};
+
+static arena_t *FRAME_ARENA = NULL;
+
+static size_t align_up(size_t size) {
+  return (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+}
+
+static char *block_alloc(size_t capacity) {
+  char *block = malloc(capacity);
+  assert(block != NULL);
+  return block;
+}
+
+arena_t *arena_init(size_t capacity) {
+  arena_t *arena = malloc(sizeof(arena_t));
+  assert(arena != NULL);
+  arena->capacity = align_up(capacity > 0 ? capacity : 1);
+  arena->block = block_alloc(arena->capacity);
+  arena->used = 0;
+  arena->overflow = NULL;
+  arena->cycle_bytes = 0;
+  arena->stats = (arena_stats_t){0};
+  return arena;
+}
+
+static void free_overflow(arena_t *arena) {
+  chunk_t *chunk = arena->overflow;
+  while (chunk != NULL) {
+    chunk_t *next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+  arena->overflow = NULL;
+}
+
+void arena_free(arena_t *arena) {
+  free_overflow(arena);
+  free(arena->block);
+  free(arena);
+}
+
+/** Serves an allocation from a new or partly used overflow chunk */
+static void *overflow_alloc(arena_t *arena, size_t size) {
+  chunk_t *chunk = arena->overflow;
+  if (chunk == NULL || chunk->capacity - chunk->used < size) {
+    // At least as big as everything handed out so far, so chunks double
+    size_t capacity = arena->cycle_bytes > arena->capacity ? arena->cycle_bytes
+                                                           : arena->capacity;
+    if (capacity < size) {
+      capacity = size;
+    }
+    chunk = malloc(sizeof(chunk_t) + capacity);
+    assert(chunk != NULL);
+    chunk->next = arena->overflow;
+    chunk->capacity = capacity;
+    chunk->used = 0;
+    arena->overflow = chunk;
+    arena->stats.heap_allocations++;
+  }
+  void *memory = (char *)chunk->data + chunk->used;
+  chunk->used += size;
+  return memory;
+}
+
+void *arena_alloc(arena_t *arena, size_t size) {
+  size = align_up(size > 0 ? size : 1);
+  arena->stats.allocations++;
+  arena->stats.bytes += size;
+  arena->cycle_bytes += size;
+  if (arena->capacity - arena->used >= size) {
+    void *memory = arena->block + arena->used;
+    arena->used += size;
+    return memory;
+  }
+  return overflow_alloc(arena, size);
+}
+
+void *arena_alloc_array(arena_t *arena, size_t count, size_t size) {
+  assert(size == 0 || count <= SIZE_MAX / size);
+  return arena_alloc(arena, count * size);
+}
+
+void arena_reset(arena_t *arena) {
+  if (arena->cycle_bytes > arena->stats.peak_bytes) {
+    arena->stats.peak_bytes = arena->cycle_bytes;
+  }
+  if (arena->overflow != NULL) {
+    // Grow the block to fit the whole cycle with room to spare
+    free_overflow(arena);
+    free(arena->block);
+    arena->capacity = align_up(arena->cycle_bytes * 2);
+    arena->block = block_alloc(arena->capacity);
+    arena->stats.heap_allocations++;
+  }
+  arena->used = 0;
+  arena->cycle_bytes = 0;
+  arena->stats.resets++;
+}
+
+arena_stats_t arena_get_stats(arena_t *arena) { return arena->stats; }
+
+arena_t *frame_arena(void) {
+  if (FRAME_ARENA == NULL) {
+    FRAME_ARENA = arena_init(FRAME_ARENA_CAPACITY);
+  }
+  return FRAME_ARENA;
+}
+
+void frame_arena_reset(void) { arena_reset(frame_arena()); }
+
+void frame_arena_free(void) {
+  if (FRAME_ARENA != NULL) {
+    arena_free(FRAME_ARENA);
+    FRAME_ARENA = NULL;
+  }
+}
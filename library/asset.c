@@ -5,14 +5,17 @@
 #include "asset.h"
 #include "asset_cache.h"
 #include "color.h"
+#include "ptr_map.h"
 #include "sdl_wrapper.h"
 
-static list_t *ASSET_LIST = NULL;
 const size_t INIT_CAPACITY = 5;
 
 typedef struct asset {
   asset_type_t type;
   SDL_Rect bounding_box;
+  /** Neighbours in the asset list, in the order assets were made */
+  struct asset *prev;
+  struct asset *next;
 } asset_t;
 
 typedef struct text_asset {
@@ -26,10 +29,27 @@ typedef struct image_asset {
   asset_t base;
   SDL_Texture *texture;
   body_t *body;
+  /** The next image drawn on the same body, or NULL */
+  struct image_asset *next_on_body;
 } image_asset_t;
 
 /**
- * Allocates memory for an asset with the given parameters.
+ * The asset list, an intrusive doubly-linked list, so any asset can be
+ * unlinked in O(1).
+ */
+static asset_t *first_asset = NULL;
+static asset_t *last_asset = NULL;
+static size_t num_assets = 0;
+
+/**
+ * Maps each body to its newest image asset.
+ * The body's older images follow it through next_on_body.
+ */
+static ptr_map_t *BODY_IMAGES = NULL;
+
+/**
+ * Allocates memory for an asset with the given parameters
+ * and appends it to the asset list.
  *
  * @param ty the type of the asset
  * @param bounding_box the bounding box containing the location and dimensions
@@ -39,68 +59,101 @@ typedef struct image_asset {
 static asset_t *asset_init(asset_type_t ty, SDL_Rect bounding_box) {
   // This is a fancy way of malloc'ing space for an `image_asset_t` if `ty` is
   // ASSET_IMAGE, and `text_asset_t` otherwise.
-  if (ASSET_LIST == NULL) {
-    ASSET_LIST = list_init(INIT_CAPACITY, (free_func_t)asset_destroy);
+  if (BODY_IMAGES == NULL) {
+    BODY_IMAGES = ptr_map_init(INIT_CAPACITY);
   }
   asset_t *new =
       malloc(ty == ASSET_IMAGE ? sizeof(image_asset_t) : sizeof(text_asset_t));
   assert(new);
   new->type = ty;
   new->bounding_box = bounding_box;
+
+  new->prev = last_asset;
+  new->next = NULL;
+  if (last_asset != NULL) {
+    last_asset->next = new;
+  } else {
+    first_asset = new;
+  }
+  last_asset = new;
+  num_assets++;
   return new;
 }
 
+/** Unlinks an asset from the asset list in O(1) and frees it */
+static void asset_unlink(asset_t *asset) {
+  if (asset->prev != NULL) {
+    asset->prev->next = asset->next;
+  } else {
+    first_asset = asset->next;
+  }
+  if (asset->next != NULL) {
+    asset->next->prev = asset->prev;
+  } else {
+    last_asset = asset->prev;
+  }
+  num_assets--;
+  asset_destroy(asset);
+}
+
 void asset_make_image_with_body(const char *filepath, body_t *body) {
-  image_asset_t *img = malloc(sizeof(image_asset_t));
-  img->base = *asset_init(ASSET_IMAGE, (SDL_Rect){0, 0, 0, 0});
+  image_asset_t *img =
+      (image_asset_t *)asset_init(ASSET_IMAGE, (SDL_Rect){0, 0, 0, 0});
   img->texture =
       (SDL_Texture *)asset_cache_obj_get_or_create(ASSET_IMAGE, filepath);
   img->body = body;
-  list_add(ASSET_LIST, img);
+
+  // Chain the image in front of any others already drawn on the body
+  void *first = NULL;
+  ptr_map_get(BODY_IMAGES, body, &first);
+  img->next_on_body = first;
+  ptr_map_put(BODY_IMAGES, body, img);
 }
 
 void asset_make_image(const char *filepath, SDL_Rect bounding_box) {
-  image_asset_t *img = malloc(sizeof(image_asset_t));
-  img->base = *asset_init(ASSET_IMAGE, bounding_box);
+  image_asset_t *img = (image_asset_t *)asset_init(ASSET_IMAGE, bounding_box);
   img->texture =
       (SDL_Texture *)asset_cache_obj_get_or_create(ASSET_IMAGE, filepath);
   img->body = NULL;
-  list_add(ASSET_LIST, img);
+  img->next_on_body = NULL;
 }
 
 void asset_make_text(const char *filepath, SDL_Rect bounding_box,
                      const char *text, color_t color) {
-  text_asset_t *text_asset = malloc(sizeof(text_asset_t));
-  text_asset->base = *asset_init(ASSET_TEXT, bounding_box);
+  text_asset_t *text_asset =
+      (text_asset_t *)asset_init(ASSET_TEXT, bounding_box);
   text_asset->font =
       (TTF_Font *)asset_cache_obj_get_or_create(ASSET_TEXT, filepath);
   text_asset->text = text;
   text_asset->color = color;
-  list_add(ASSET_LIST, text_asset);
 }
 
 void asset_reset_asset_list() {
-  if (ASSET_LIST != NULL) {
-    list_free(ASSET_LIST);
+  while (first_asset != NULL) {
+    asset_unlink(first_asset);
+  }
+  if (BODY_IMAGES != NULL) {
+    ptr_map_free(BODY_IMAGES);
+    BODY_IMAGES = NULL;
   }
-  ASSET_LIST = list_init(INIT_CAPACITY, (free_func_t)asset_destroy);
 }
 
-list_t *asset_get_asset_list() { return ASSET_LIST; }
+size_t asset_count() { return num_assets; }
 
 void asset_remove_body(body_t *body) {
-  ssize_t size = list_size(ASSET_LIST);
-  for (ssize_t i = 0; i < size; i++) {
-    asset_t *asset = list_get(ASSET_LIST, i);
-    if (asset->type == ASSET_IMAGE) {
-      image_asset_t *image_asset = (image_asset_t *)asset;
-      if (image_asset->body == body) {
-        list_remove(ASSET_LIST, i);
-        asset_destroy(asset);
-        size--;
-        i--;
-      }
-    }
+  if (BODY_IMAGES == NULL) {
+    return;
+  }
+  void *first;
+  if (!ptr_map_get(BODY_IMAGES, body, &first)) {
+    return;
+  }
+  ptr_map_remove(BODY_IMAGES, body);
+  image_asset_t *img = first;
+  while (img != NULL) {
+    image_asset_t *next = img->next_on_body;
+    asset_unlink((asset_t *)img);
+    img = next;
   }
 }
 
@@ -110,6 +163,9 @@ void asset_render(asset_t *asset) {
   if (type == ASSET_IMAGE) {
     image_asset_t *img = (image_asset_t *)asset;
     if (img->body) {
+      if (!sdl_body_visible(img->body)) {
+        return;
+      }
       SDL_Rect bounding_box = sdl_get_body_bounding_box(img->body);
       sdl_render_image(img->texture, &bounding_box);
     } else {
@@ -124,4 +180,10 @@ void asset_render(asset_t *asset) {
   }
 }
 
-void asset_destroy(asset_t *asset) { free(asset); }
\ No newline at end of file
+void asset_render_all() {
+  for (asset_t *asset = first_asset; asset != NULL; asset = asset->next) {
+    asset_render(asset);
+  }
+}
+
+void asset_destroy(asset_t *asset) { free(asset); }
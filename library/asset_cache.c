@@ -1,8 +1,11 @@
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
 #include <assert.h>
+#include <stdint.h>
+#include <string.h>
 
 #include "asset_cache.h"
+#include "constants.h"
 #include "list.h"
 #include "sdl_wrapper.h"
 
@@ -10,60 +13,230 @@ static list_t *ASSET_CACHE;
 
 const size_t ASSET_CACHE_FONT_SIZE = 18;
 const size_t INITIAL_CAPACITY = 5;
+const size_t INITIAL_TABLE_CAPACITY = 32;
 
 typedef struct {
   asset_type_t type;
-  const char *filepath;
+  /** The cache's own copy of the path, shared by every alias of it */
+  char *filepath;
+  /** The font size for ASSET_TEXT entries, 0 for images */
+  size_t font_size;
+  uint32_t hash;
+  bool loaded;
   void *obj;
 } entry_t;
 
+/**
+ * A slot in an open-addressing table. Empty slots have a NULL entry.
+ */
+typedef struct {
+  const char *key;
+  size_t font_size;
+  uint32_t hash;
+  entry_t *entry;
+} slot_t;
+
+/**
+ * A linear-probing hash table with a power-of-two capacity.
+ * by_name tables compare keys by string contents;
+ * the others compare them by address.
+ */
+typedef struct {
+  slot_t *slots;
+  size_t capacity;
+  size_t size;
+  bool by_name;
+} table_t;
+
+/**
+ * Maps the addresses of the image path constants in constants.c to their
+ * entries, so lookups with them never read the string. Only those pointers
+ * are added: they are never written, so an address always names one path.
+ */
+static table_t BY_ADDRESS;
+/**
+ * Maps path contents to entries, used to intern a path seen for the first time.
+ */
+static table_t BY_NAME;
+
+static asset_cache_stats_t stats;
+
+/** FNV-1a over the path, mixed with the font size */
+static uint32_t hash_name(const char *filepath, size_t font_size) {
+  uint32_t hash = 2166136261u;
+  for (const char *c = filepath; *c != '\0'; c++) {
+    hash = (hash ^ (uint8_t)*c) * 16777619u;
+  }
+  return (hash ^ (uint32_t)font_size) * 16777619u;
+}
+
+/** Fibonacci hashing of the path's address, mixed with the font size */
+static uint32_t hash_address(const char *filepath, size_t font_size) {
+  uint64_t bits = (uint64_t)(uintptr_t)filepath ^ ((uint64_t)font_size << 48);
+  return (uint32_t)((bits * 11400714819323198485ull) >> 32);
+}
+
+static void table_init(table_t *table, bool by_name) {
+  table->capacity = INITIAL_TABLE_CAPACITY;
+  table->size = 0;
+  table->by_name = by_name;
+  table->slots = calloc(table->capacity, sizeof(slot_t));
+  assert(table->slots != NULL);
+}
+
+static bool slot_matches(table_t *table, slot_t *slot, const char *key,
+                         size_t font_size, uint32_t hash) {
+  if (slot->hash != hash || slot->font_size != font_size) {
+    return false;
+  }
+  return slot->key == key || (table->by_name && strcmp(slot->key, key) == 0);
+}
+
+static slot_t *table_probe(table_t *table, const char *key, size_t font_size,
+                           uint32_t hash) {
+  size_t mask = table->capacity - 1;
+  for (size_t i = hash & mask;; i = (i + 1) & mask) {
+    slot_t *slot = &table->slots[i];
+    if (slot->entry == NULL ||
+        slot_matches(table, slot, key, font_size, hash)) {
+      return slot;
+    }
+  }
+}
+
+static void table_insert(table_t *table, const char *key, size_t font_size,
+                         uint32_t hash, entry_t *entry);
+
+/** Doubles the capacity once the table is three quarters full */
+static void table_grow(table_t *table) {
+  slot_t *old_slots = table->slots;
+  size_t old_capacity = table->capacity;
+  table->capacity *= 2;
+  table->size = 0;
+  table->slots = calloc(table->capacity, sizeof(slot_t));
+  assert(table->slots != NULL);
+  for (size_t i = 0; i < old_capacity; i++) {
+    slot_t *slot = &old_slots[i];
+    if (slot->entry != NULL) {
+      table_insert(table, slot->key, slot->font_size, slot->hash, slot->entry);
+    }
+  }
+  free(old_slots);
+}
+
+static void table_insert(table_t *table, const char *key, size_t font_size,
+                         uint32_t hash, entry_t *entry) {
+  if ((table->size + 1) * 4 > table->capacity * 3) {
+    table_grow(table);
+  }
+  slot_t *slot = table_probe(table, key, font_size, hash);
+  assert(slot->entry == NULL);
+  *slot = (slot_t){
+      .key = key, .font_size = font_size, .hash = hash, .entry = entry};
+  table->size++;
+}
+
 static void asset_cache_free_entry(entry_t *entry) {
   asset_type_t type = entry->type;
 
-  if (type == ASSET_IMAGE) {
-    SDL_DestroyTexture((SDL_Texture *)entry->obj);
-  } else {
-    TTF_CloseFont((TTF_Font *)entry->obj);
+  if (entry->obj != NULL) {
+    if (type == ASSET_IMAGE) {
+      SDL_DestroyTexture((SDL_Texture *)entry->obj);
+    } else {
+      TTF_CloseFont((TTF_Font *)entry->obj);
+    }
   }
+  free(entry->filepath);
   free(entry);
 }
 
+/**
+ * Finds the entry for a path, interning the path if it is new.
+ * The object is not loaded here.
+ */
+static entry_t *get_or_intern_entry(asset_type_t ty, const char *filepath,
+                                    size_t font_size) {
+  uint32_t address_hash = hash_address(filepath, font_size);
+  slot_t *slot = table_probe(&BY_ADDRESS, filepath, font_size, address_hash);
+  if (slot->entry != NULL) {
+    return slot->entry;
+  }
+
+  uint32_t name_hash = hash_name(filepath, font_size);
+  entry_t *entry =
+      table_probe(&BY_NAME, filepath, font_size, name_hash)->entry;
+  if (entry == NULL) {
+    entry = malloc(sizeof(entry_t));
+    assert(entry != NULL);
+    entry->type = ty;
+    entry->filepath = strdup(filepath);
+    assert(entry->filepath != NULL);
+    entry->font_size = font_size;
+    entry->hash = name_hash;
+    entry->loaded = false;
+    entry->obj = NULL;
+    list_add(ASSET_CACHE, entry);
+    table_insert(&BY_NAME, entry->filepath, font_size, name_hash, entry);
+  }
+  return entry;
+}
+
 void asset_cache_init() {
   ASSET_CACHE =
       list_init(INITIAL_CAPACITY, (free_func_t)asset_cache_free_entry);
-}
+  table_init(&BY_ADDRESS, false);
+  table_init(&BY_NAME, true);
+  stats = (asset_cache_stats_t){0};
 
-void asset_cache_destroy() { list_free(ASSET_CACHE); }
-
-entry_t *check_entry(const char *filepath) {
-  for (size_t i = 0; i < list_size(ASSET_CACHE); ++i) {
-    entry_t *entry = list_get(ASSET_CACHE, i);
-    if (strcmp(entry->filepath, filepath) == 0) {
-      return entry;
+  // Hash the image paths from constants.c up front.
+  // Their textures are still loaded on first use, once a renderer exists.
+  for (size_t i = 0; i < NUM_IMAGE_PATHS; i++) {
+    const char *path = *IMAGE_PATHS[i];
+    entry_t *entry = get_or_intern_entry(ASSET_IMAGE, path, 0);
+    uint32_t address_hash = hash_address(path, 0);
+    if (table_probe(&BY_ADDRESS, path, 0, address_hash)->entry == NULL) {
+      table_insert(&BY_ADDRESS, path, 0, address_hash, entry);
     }
   }
-  return NULL;
 }
 
-void *asset_cache_obj_get_or_create(asset_type_t ty, const char *filepath) {
+void asset_cache_destroy() {
+  list_free(ASSET_CACHE);
+  free(BY_ADDRESS.slots);
+  free(BY_NAME.slots);
+}
 
-  entry_t *entry = check_entry(filepath);
-  if (entry) {
-    assert(ty == entry->type);
+/**
+ * Returns the object for a (path, font size) pair, loading it on first use.
+ */
+static void *get_or_load(asset_type_t ty, const char *filepath,
+                         size_t font_size) {
+  entry_t *entry = get_or_intern_entry(ty, filepath, font_size);
+  assert(ty == entry->type);
+  if (entry->loaded) {
+    stats.hits++;
     return entry->obj;
   }
 
-  entry_t *new_entry = malloc(sizeof(entry_t));
-  new_entry->type = ty;
-  new_entry->filepath = filepath;
-
-  void *obj;
+  stats.misses++;
   if (ty == ASSET_IMAGE) {
-    obj = sdl_get_image_texture(filepath);
+    entry->obj = sdl_get_image_texture(filepath);
   } else {
-    obj = TTF_OpenFont(filepath, ASSET_CACHE_FONT_SIZE);
+    entry->obj = sdl_get_font(filepath, font_size);
   }
-  new_entry->obj = obj;
-  list_add(ASSET_CACHE, new_entry);
-  return new_entry->obj;
+  entry->loaded = true;
+  return entry->obj;
 }
+
+void *asset_cache_obj_get_or_create(asset_type_t ty, const char *filepath) {
+  size_t font_size = ty == ASSET_IMAGE ? 0 : ASSET_CACHE_FONT_SIZE;
+  return get_or_load(ty, filepath, font_size);
+}
+
+TTF_Font *asset_cache_font_get_or_create(const char *filepath,
+                                         size_t font_size) {
+  assert(font_size > 0);
+  return (TTF_Font *)get_or_load(ASSET_TEXT, filepath, font_size);
+}
+
+asset_cache_stats_t asset_cache_get_stats() { return stats; }
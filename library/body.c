@@ -0,0 +1,174 @@
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+#include "asset.h"
+#include "body.h"
+
+struct body {
+  /** The vertices, at the body's current position and rotation */
+  list_t *shape;
+  vector_t centroid;
+  vector_t velocity;
+  double mass;
+  color_t color;
+  double rotation;
+  /** The force and impulse added since the last tick */
+  vector_t force;
+  vector_t impulse;
+  void *info;
+  free_func_t info_freer;
+  bool removed;
+};
+
+/** Returns the signed area of a polygon; positive if counterclockwise */
+static double signed_area(list_t *shape) {
+  size_t n = list_size(shape);
+  double twice_area = 0;
+  for (size_t i = 0; i < n; i++) {
+    vector_t *v1 = list_get(shape, i);
+    vector_t *v2 = list_get(shape, (i + 1) % n);
+    twice_area += vec_cross(*v1, *v2);
+  }
+  return twice_area / 2;
+}
+
+/**
+ * Returns the centroid of a polygon.
+ * Shapes with no area (points and segments) use the mean of their vertices.
+ */
+static vector_t polygon_centroid(list_t *shape) {
+  size_t n = list_size(shape);
+  assert(n > 0);
+  double area = signed_area(shape);
+  vector_t sum = VEC_ZERO;
+  if (area == 0) {
+    for (size_t i = 0; i < n; i++) {
+      sum = vec_add(sum, *(vector_t *)list_get(shape, i));
+    }
+    return vec_multiply(1.0 / n, sum);
+  }
+  for (size_t i = 0; i < n; i++) {
+    vector_t *v1 = list_get(shape, i);
+    vector_t *v2 = list_get(shape, (i + 1) % n);
+    sum = vec_add(sum, vec_multiply(vec_cross(*v1, *v2), vec_add(*v1, *v2)));
+  }
+  return vec_multiply(1.0 / (6 * area), sum);
+}
+
+body_t *body_init(list_t *shape, double mass, color_t color) {
+  return body_init_with_info(shape, mass, color, NULL, NULL);
+}
+
+body_t *body_init_with_info(list_t *shape, double mass, color_t color,
+                            void *info, free_func_t info_freer) {
+  assert(mass > 0);
+  body_t *body = malloc(sizeof(body_t));
+  assert(body != NULL);
+  body->shape = shape;
+  body->centroid = polygon_centroid(shape);
+  body->velocity = VEC_ZERO;
+  body->mass = mass;
+  body->color = color;
+  body->rotation = 0;
+  body->force = VEC_ZERO;
+  body->impulse = VEC_ZERO;
+  body->info = info;
+  body->info_freer = info_freer;
+  body->removed = false;
+  return body;
+}
+
+list_t *body_get_shape(body_t *body) {
+  size_t n = list_size(body->shape);
+  list_t *shape = list_init(n > 0 ? n : 1, free);
+  for (size_t i = 0; i < n; i++) {
+    vector_t *vertex = malloc(sizeof(vector_t));
+    assert(vertex != NULL);
+    *vertex = *(vector_t *)list_get(body->shape, i);
+    list_add(shape, vertex);
+  }
+  return shape;
+}
+
+void *body_get_info(body_t *body) { return body->info; }
+
+vector_t body_get_centroid(body_t *body) { return body->centroid; }
+
+void body_set_centroid(body_t *body, vector_t x) {
+  vector_t offset = vec_subtract(x, body->centroid);
+  size_t n = list_size(body->shape);
+  for (size_t i = 0; i < n; i++) {
+    vector_t *vertex = list_get(body->shape, i);
+    *vertex = vec_add(*vertex, offset);
+  }
+  body->centroid = x;
+}
+
+vector_t body_get_velocity(body_t *body) { return body->velocity; }
+
+void body_set_velocity(body_t *body, vector_t v) { body->velocity = v; }
+
+double body_area(body_t *body) { return fabs(signed_area(body->shape)); }
+
+color_t body_get_color(body_t *body) { return body->color; }
+
+void body_set_color(body_t *body, color_t color) { body->color = color; }
+
+double body_get_rotation(body_t *body) { return body->rotation; }
+
+void body_set_rotation(body_t *body, double angle) {
+  double delta = angle - body->rotation;
+  size_t n = list_size(body->shape);
+  for (size_t i = 0; i < n; i++) {
+    vector_t *vertex = list_get(body->shape, i);
+    vector_t relative = vec_subtract(*vertex, body->centroid);
+    *vertex = vec_add(body->centroid, vec_rotate(relative, delta));
+  }
+  body->rotation = angle;
+}
+
+void body_tick(body_t *body, double dt) {
+  vector_t old_velocity = body->velocity;
+  if (body->mass != INFINITY) {
+    vector_t dv = vec_add(vec_multiply(dt / body->mass, body->force),
+                          vec_multiply(1.0 / body->mass, body->impulse));
+    body->velocity = vec_add(body->velocity, dv);
+  }
+  vector_t average = vec_multiply(0.5, vec_add(old_velocity, body->velocity));
+  if (average.x != 0 || average.y != 0) {
+    body_set_centroid(body,
+                      vec_add(body->centroid, vec_multiply(dt, average)));
+  }
+  body_reset(body);
+}
+
+double body_get_mass(body_t *body) { return body->mass; }
+
+void body_add_force(body_t *body, vector_t force) {
+  body->force = vec_add(body->force, force);
+}
+
+void body_add_impulse(body_t *body, vector_t impulse) {
+  body->impulse = vec_add(body->impulse, impulse);
+}
+
+void body_reset(body_t *body) {
+  body->force = VEC_ZERO;
+  body->impulse = VEC_ZERO;
+}
+
+void body_remove(body_t *body) { body->removed = true; }
+
+bool body_is_removed(body_t *body) { return body->removed; }
+
+void body_free(body_t *body) {
+  // As the ref body does, so a body later allocated at this address
+  // doesn't inherit its images
+  asset_remove_body(body);
+  list_free(body->shape);
+  if (body->info_freer != NULL) {
+    body->info_freer(body->info);
+  }
+  free(body);
+}
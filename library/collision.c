@@ -2,94 +2,128 @@
 #include "body.h"
 #include "constants.h"
 #include "platforms.h"
+#include "ptr_map.h"
 #include "scene.h"
+#include "vec_batch.h"
 
 #include <assert.h>
 #include <math.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 
+const size_t SHAPE_CACHE_INIT_CAPACITY = 64;
+
 /**
- * Returns a list of vectors representing the edges of a shape.
- *
- * @param shape the list of vectors representing the vertices of a shape
- * @return a list of vectors representing the edges of the shape
+ * A body's shape, as of the last time it was tested.
+ * The shape is rebuilt if the body's info or rotation has changed.
+ * Entries are dropped when their body is freed (see collision_forget_body()),
+ * so a body allocated at the same address later starts without one.
  */
-static list_t *get_edges(list_t *shape) {
-  list_t *edges = list_init(list_size(shape), free);
+typedef struct {
+  body_t *body;
+  void *info;
+  double rotation;
+  /** The entry's position in shape_entries */
+  size_t index;
+  collision_shape_t shape;
+} cached_shape_t;
 
-  for (size_t i = 0; i < list_size(shape); i++) {
-    vector_t *vec = malloc(sizeof(vector_t));
-    assert(vec);
-    *vec =
-        vec_subtract(*(vector_t *)list_get(shape, i % list_size(shape)),
-                     *(vector_t *)list_get(shape, (i + 1) % list_size(shape)));
-    list_add(edges, vec);
+/**
+ * Maps every body that has been tested to its cached shape.
+ * Entries are allocated once per body, so their shapes don't move;
+ * shape_entries lists them so they can all be freed.
+ */
+static ptr_map_t *shape_cache = NULL;
+static cached_shape_t **shape_entries = NULL;
+static size_t num_shape_entries = 0;
+static size_t shape_entries_capacity = 0;
+/** Scratch space for the vertices of the shape being built */
+static vec_array_t *shape_vertices = NULL;
+
+void collision_shape_init(collision_shape_t *shape, vec_array_t *vertices,
+                          vector_t origin) {
+  size_t n = vec_array_size(vertices);
+  shape->num_vertices = n;
+  shape->vertices = shape->storage;
+  if (n > COLLISION_MAX_VERTICES) {
+    shape->vertices = malloc(sizeof(vector_t) * 2 * n);
+    assert(shape->vertices != NULL);
+  }
+  shape->normals = shape->vertices + n;
+  vec_batch_translate(shape->vertices, vec_array_data(vertices), n,
+                      vec_negate(origin));
+  aabb_t bounds = {{__DBL_MAX__, __DBL_MAX__}, {-__DBL_MAX__, -__DBL_MAX__}};
+  for (size_t i = 0; i < n; i++) {
+    vector_t v = shape->vertices[i];
+    bounds.min = (vector_t){fmin(bounds.min.x, v.x), fmin(bounds.min.y, v.y)};
+    bounds.max = (vector_t){fmax(bounds.max.x, v.x), fmax(bounds.max.y, v.y)};
   }
+  shape->bounds = bounds;
+  for (size_t i = 0; i < n; i++) {
+    vector_t edge =
+        vec_subtract(shape->vertices[i], shape->vertices[(i + 1) % n]);
+    vector_t axis = {-edge.y, edge.x};
+    shape->normals[i] = vec_multiply(1 / vec_get_length(axis), axis);
+  }
+}
 
-  return edges;
+void collision_shape_free(collision_shape_t *shape) {
+  if (shape->vertices != shape->storage) {
+    free(shape->vertices);
+  }
+  shape->vertices = shape->storage;
+  shape->num_vertices = 0;
 }
 
 /**
  * Returns a vector containing the maximum and minimum length projections given
  * a unit axis and shape.
  *
- * @param shape the list of vectors representing the vertices of a shape
- * @param unit_axis the unit axis to project eeach vertex on
+ * @param shape the shape to project
+ * @param offset the projection of the shape's origin on the axis
+ * @param unit_axis the unit axis to project each vertex on
  * @return a vector in the form (max, min) where `max` is the maximum projection
  * length and `min` is the minimum projection length.
  */
-static vector_t get_max_min_projections(list_t *shape, vector_t unit_axis) {
-  // TODO: copy and paste your implementation from last week!
-  double min = __DBL_MAX__;
-  double max = -__DBL_MAX__;
-
-  size_t vertexs = list_size(shape);
-  for (size_t i = 0; i < vertexs; i++) {
-    vector_t v = *(vector_t *)list_get(shape, i);
-    double proj = vec_dot(v, unit_axis);
-
-    if (proj < min) {
-      min = proj;
-    }
-    if (proj > max) {
-      max = proj;
-    }
-  }
-  return (vector_t){max, min};
+static vector_t get_max_min_projections(const collision_shape_t *shape,
+                                        double offset, vector_t unit_axis) {
+  double min, max;
+  vec_batch_project(shape->vertices, shape->num_vertices, unit_axis, &min,
+                    &max);
+  return (vector_t){max + offset, min + offset};
 }
 
 /**
- * Determines whether two convex polygons intersect.
- * The polygons are given as lists of vertices in counterclockwise order.
- * There is an edge between each pair of consecutive vertices,
- * and one between the first vertex and the last vertex.
+ * Tests two convex polygons against the edge normals of the first.
+ * The polygons are given as shapes in counterclockwise order.
  *
- * @param shape1 the first shape
- * @param shape2 the second shape
- * @return whether the shapes are colliding
+ * @param shape1 the shape whose edge normals are tested
+ * @param position1 where the first shape's origin is
+ * @param shape2 the other shape
+ * @param position2 where the second shape's origin is
+ * @param min_overlap set to the smallest overlap found
+ * @return whether the shapes overlap on every tested axis,
+ * and the axis with the smallest overlap
  */
-static collision_info_t compare_collision(list_t *shape1, list_t *shape2,
+static collision_info_t compare_collision(const collision_shape_t *shape1,
+                                          vector_t position1,
+                                          const collision_shape_t *shape2,
+                                          vector_t position2,
                                           double *min_overlap) {
-
   collision_info_t info = {.collided = false, .axis = {0, 0}};
-  list_t *edges1 = get_edges(shape1);
-
-  for (size_t i = 0; i < list_size(edges1); i++) {
-    vector_t edge = *(vector_t *)list_get(edges1, i);
-    vector_t axis = {-edge.y, edge.x};
-
-    double len = vec_get_length(axis);
 
-    vector_t unit_axis = {axis.x / len, axis.y / len};
+  for (size_t i = 0; i < shape1->num_vertices; i++) {
+    vector_t unit_axis = shape1->normals[i];
 
-    vector_t proj1 = get_max_min_projections(shape1, unit_axis);
-    vector_t proj2 = get_max_min_projections(shape2, unit_axis);
+    vector_t proj1 = get_max_min_projections(shape1, vec_dot(position1, unit_axis),
+                                             unit_axis);
+    vector_t proj2 = get_max_min_projections(shape2, vec_dot(position2, unit_axis),
+                                             unit_axis);
 
     double overlap = fmin(proj1.x, proj2.x) - fmax(proj1.y, proj2.y);
 
     if (overlap <= 0) {
-      list_free(edges1);
       return info;
     }
 
@@ -98,28 +132,24 @@ static collision_info_t compare_collision(list_t *shape1, list_t *shape2,
       info.axis = unit_axis;
     }
   }
-  list_free(edges1);
   info.collided = true;
   return info;
 }
 
-collision_info_t find_collision(body_t *body1, body_t *body2) {
-  list_t *shape1 = body_get_shape(body1);
-  list_t *shape2 = body_get_shape(body2);
-
+collision_info_t find_shape_collision(const collision_shape_t *shape1,
+                                      vector_t position1,
+                                      const collision_shape_t *shape2,
+                                      vector_t position2) {
   double c1_overlap = __DBL_MAX__;
   double c2_overlap = __DBL_MAX__;
 
-  collision_info_t collision1 = compare_collision(shape1, shape2, &c1_overlap);
-  collision_info_t collision2 = compare_collision(shape2, shape1, &c2_overlap);
-
-  list_free(shape1);
-  list_free(shape2);
-
+  collision_info_t collision1 =
+      compare_collision(shape1, position1, shape2, position2, &c1_overlap);
   if (!collision1.collided) {
     return collision1;
   }
-
+  collision_info_t collision2 =
+      compare_collision(shape2, position2, shape1, position1, &c2_overlap);
   if (!collision2.collided) {
     return collision2;
   }
@@ -130,42 +160,169 @@ collision_info_t find_collision(body_t *body1, body_t *body2) {
   return collision2;
 }
 
+static void build_body_shape(body_t *body, collision_shape_t *shape) {
+  if (shape_vertices == NULL) {
+    shape_vertices = vec_array_init(COLLISION_MAX_VERTICES);
+  }
+  list_t *vertices = body_get_shape(body);
+  vec_array_clear(shape_vertices);
+  vec_array_append_list(shape_vertices, vertices);
+  list_free(vertices);
+  collision_shape_init(shape, shape_vertices, body_get_centroid(body));
+}
+
+/** Adds an entry for a body, to be filled by build_body_shape() */
+static cached_shape_t *add_cache_entry(body_t *body) {
+  if (shape_cache == NULL) {
+    shape_cache = ptr_map_init(SHAPE_CACHE_INIT_CAPACITY);
+  }
+  if (num_shape_entries == shape_entries_capacity) {
+    shape_entries_capacity = shape_entries_capacity
+                                 ? shape_entries_capacity * 2
+                                 : SHAPE_CACHE_INIT_CAPACITY;
+    shape_entries = realloc(shape_entries, sizeof(cached_shape_t *) *
+                                               shape_entries_capacity);
+    assert(shape_entries != NULL);
+  }
+  cached_shape_t *entry = malloc(sizeof(cached_shape_t));
+  assert(entry != NULL);
+  entry->body = body;
+  entry->index = num_shape_entries;
+  shape_entries[num_shape_entries++] = entry;
+  ptr_map_put(shape_cache, body, entry);
+  return entry;
+}
+
+/**
+ * Returns a body's cached shape, building it from the body's vertices
+ * on the first test.
+ */
+static const collision_shape_t *get_cached_shape(body_t *body) {
+  cached_shape_t *entry = NULL;
+  void *info = body_get_info(body);
+  double rotation = body_get_rotation(body);
+  if (shape_cache == NULL ||
+      !ptr_map_get(shape_cache, body, (void **)&entry)) {
+    entry = add_cache_entry(body);
+  } else if (entry->info == info && entry->rotation == rotation) {
+    return &entry->shape;
+  } else {
+    collision_shape_free(&entry->shape);
+  }
+  build_body_shape(body, &entry->shape);
+  entry->info = info;
+  entry->rotation = rotation;
+  return &entry->shape;
+}
+
+void collision_forget_body(body_t *body) {
+  cached_shape_t *entry;
+  if (shape_cache == NULL || !ptr_map_get(shape_cache, body, (void **)&entry)) {
+    return;
+  }
+  ptr_map_remove(shape_cache, body);
+  // Swap the last entry into the freed position
+  cached_shape_t *last = shape_entries[--num_shape_entries];
+  shape_entries[entry->index] = last;
+  last->index = entry->index;
+  collision_shape_free(&entry->shape);
+  free(entry);
+}
+
+void collision_cache_free(void) {
+  for (size_t i = 0; i < num_shape_entries; i++) {
+    collision_shape_free(&shape_entries[i]->shape);
+    free(shape_entries[i]);
+  }
+  free(shape_entries);
+  shape_entries = NULL;
+  num_shape_entries = 0;
+  shape_entries_capacity = 0;
+  if (shape_cache != NULL) {
+    ptr_map_free(shape_cache);
+    shape_cache = NULL;
+  }
+  if (shape_vertices != NULL) {
+    vec_array_free(shape_vertices);
+    shape_vertices = NULL;
+  }
+}
+
+aabb_t collision_body_aabb(body_t *body) {
+  aabb_t bounds = get_cached_shape(body)->bounds;
+  vector_t centroid = body_get_centroid(body);
+  return (aabb_t){vec_add(centroid, bounds.min), vec_add(centroid, bounds.max)};
+}
+
+bool aabb_overlaps(aabb_t box1, aabb_t box2) {
+  return box1.min.x <= box2.max.x && box2.min.x <= box1.max.x &&
+         box1.min.y <= box2.max.y && box2.min.y <= box1.max.y;
+}
+
+vector_t *collision_copy_vertices(body_t *body, arena_t *arena,
+                                  size_t *num_vertices) {
+  const collision_shape_t *shape = get_cached_shape(body);
+  size_t n = shape->num_vertices;
+  vector_t centroid = body_get_centroid(body);
+  vector_t *vertices = arena_alloc_array(arena, n, sizeof(vector_t));
+  vec_batch_translate(vertices, shape->vertices, n, centroid);
+  *num_vertices = n;
+  return vertices;
+}
+
+collision_info_t find_collision(body_t *body1, body_t *body2) {
+  const collision_shape_t *shape1 = get_cached_shape(body1);
+  const collision_shape_t *shape2 = get_cached_shape(body2);
+  vector_t position1 = body_get_centroid(body1);
+  vector_t position2 = body_get_centroid(body2);
+  aabb_t box1 = {vec_add(position1, shape1->bounds.min),
+                 vec_add(position1, shape1->bounds.max)};
+  aabb_t box2 = {vec_add(position2, shape2->bounds.min),
+                 vec_add(position2, shape2->bounds.max)};
+  if (!aabb_overlaps(box1, box2)) {
+    return (collision_info_t){.collided = false};
+  }
+  return find_shape_collision(shape1, position1, shape2, position2);
+}
+
 
 /**
  * Determines whether the bottom of the user collides with a platform
  *
- * @param platforms_list the list of the platforms in the scene
+ * @param platforms the platforms in the scene, ordered by height
  * @param scene the scene in the state
  * @param user the doodler
  * @return whether the doodler bottom collides with the top of a platform
  */
-bool find_collision_with_user_bottom(list_t *platforms_list, scene_t *scene, body_t *user) {
+bool find_collision_with_user_bottom(platform_index_t *platforms, scene_t *scene, body_t *user) {
   // body_t *user = user;
   vector_t user_center = body_get_centroid(user);
   double user_bot_y  = user_center.y - OUTER_RADIUS;
   double user_left_x = user_center.x - OUTER_RADIUS/2.0;
   double user_right_x = user_center.x + OUTER_RADIUS/2.0;
 
-  size_t n = scene_bodies(scene);
-  for (size_t i = 1; i < n; i++) {
+  // Only platforms whose tops are within 5 of the user's feet can be landed on
+  size_t n = platform_index_size(platforms);
+  for (size_t i = platform_index_lower_bound(platforms, user_bot_y - 5);
+       i < n && platform_index_top(platforms, i) <= user_bot_y + 5; i++) {
     double body_y_velocity = body_get_velocity(user).y;
-    body_t *platform = scene_get_body(scene, i);
+    body_t *platform = platform_index_get(platforms, i);
     vector_t center_of_platform = body_get_centroid(platform);
     double plat_top_y = center_of_platform.y + PLATFORM_HEIGHT/2.0;
     double plat_left_x = center_of_platform.x - PLATFORM_WIDTH/2.0;
     double plat_right_x = center_of_platform.x + PLATFORM_WIDTH/2.0;
 
     if (user_left_x > plat_left_x - 5 && user_right_x < plat_right_x + 5 && fabs(plat_top_y - user_bot_y) <= 5 && body_y_velocity < 0) {
-      if (strcmp(body_get_info(platform), STEADY_PLATFORM_INFO) == 0 || strcmp(body_get_info(platform), MOVING_PLATFORM_INFO) == 0) {
+      if (entity_in_category(platform, CATEGORY_LANDABLE)) {
         SDL_play_sound(PLATFORM_BOUNCE_SOUND_PATH);
         return true;
       } 
-      else if (strcmp(body_get_info(platform), BREAKING_PLATFORM_INFO) == 0) {
-        asset_remove_body(platform);
-        body_t *broken = make_platform(PLATFORM_WIDTH, PLATFORM_HEIGHT, center_of_platform, BREAKING_PLATFORM_INFO);
-        list_add(platforms_list, broken);
-        scene_add_body(scene, broken);
-        asset_make_image_with_body(PLATFORM_BROKE, broken);
+      else if (entity_get_kind(platform) == ENTITY_BREAKING_PLATFORM) {
+        // Swap the platform for a broken one, which can't be landed on
+        platform_index_remove(platforms, i);
+        platform_pool_release(platform);
+        body_t *broken = platform_pool_acquire(ENTITY_BROKEN_PLATFORM, center_of_platform);
+        platform_index_add(platforms, broken);
         SDL_play_sound(BREAKING_PLATFORM_SOUND_PATH);
         return false;
       }
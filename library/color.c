@@ -0,0 +1,16 @@
+#include <stdlib.h>
+
+#include "color.h"
+
+/** Returns a random color component in [0, 1] */
+static double random_component(void) { return (double)rand() / RAND_MAX; }
+
+color_t color_get_random() {
+  return (color_t){.red = random_component(),
+                   .green = random_component(),
+                   .blue = random_component()};
+}
+
+bool color_is_equal(color_t c1, color_t c2) {
+  return c1.red == c2.red && c1.green == c2.green && c1.blue == c2.blue;
+}
@@ -27,6 +27,10 @@ const double DOODLER_BOUNCE_VELO_Y = 400;
 double DOODLE_LR_VELO = 250;
 const double ACC = 300;
 
+// fixed physics step
+const double PHYSICS_DT = 1.0 / 120.0;
+const size_t MAX_PHYSICS_SUBSTEPS = 8;
+
 // doodler constants
 const double OUTER_RADIUS = 20;
 const double INNER_RADIUS = 20;
@@ -41,7 +45,6 @@ const size_t VILLAIN_NUM_POINTS = 20;
 const vector_t VILLAIN_START_POS = {MAX.x/2 , MAX.y - 50 };
 const color_t VILLAIN_COLOR = (color_t){0, 0, 1};
 const char *VILLAIN_PATH = "assets/villain.png";
-const char *VILLAIN_INFO = "villain";
 const vector_t HOVER_RIGHT = {100, 0};
 const vector_t HOVER_LEFT = {-100,0};
 
@@ -50,9 +53,9 @@ const vector_t HOVER_LEFT = {-100,0};
 const double BULLET_RADIUS = 15;
 const double BULLET_NUM_POINTS = 20;
 const color_t BULLET_COLOR = (color_t){0, 0.5, 1};
-const char *BULLET_INFO = "bullet";
 const char *BULLET_PATH = "assets/bullet.png";
 const vector_t BULLET_VELOCITY = {0, -50};
+const size_t BULLET_POOL_CAPACITY = 32;
 
 
 // velocity stuff for platforms
@@ -64,13 +67,9 @@ const double VEL_MULT_PROB = 0.2;
 const size_t PLATFORM_HEIGHT = 20;
 const size_t PLATFORM_WIDTH = 60;
 
-const char *STEADY_PLATFORM_INFO = "steady";
 const char *STEADY_PLATFORM_PATH = "assets/steady_platform.png";
-const char *MOVING_PLATFORM_INFO = "moving";
 const char *MOVING_PLATFORM_PATH = "assets/moving_platform.png";
-const char *BREAKING_PLATFORM_INFO = "breaking";
 const char *BREAKING_PLATFORM_PATH = "assets/breaking_platform.png";
-const char *BROKEN_PLATFORM_INFO = "broken";
 const char *BROKEN_PLATFORM_PATH = "assets/broken_platform.png";
 const char *PLATFORM_BROKE = "assets/plateform-broke.png";
 
@@ -89,11 +88,20 @@ const color_t OBS_COLOR = (color_t){0.2, 0.2, 0.3};
 // background
 const char *BACKGROUND_PATH = "assets/background.png";
 
+// every image path above, interned by asset_cache_init()
+const char **const IMAGE_PATHS[] = {
+    &USER_PATH,           &VILLAIN_PATH,           &BULLET_PATH,
+    &STEADY_PLATFORM_PATH, &MOVING_PLATFORM_PATH,  &BREAKING_PLATFORM_PATH,
+    &BROKEN_PLATFORM_PATH, &PLATFORM_BROKE,        &BACKGROUND_PATH};
+const size_t NUM_IMAGE_PATHS = sizeof(IMAGE_PATHS) / sizeof(IMAGE_PATHS[0]);
+
 // Font constants
 const vector_t FONT_POSITION = {0, 0};
 const vector_t FONT_SIZE = {100, 30};
 const char *GAMEOVER_FONT = "assets/Roboto-Regular.ttf";
 const char *FONT = "assets/Doodle-Font.ttf";
+const size_t TEXT_FONT_SIZE = 30;
+const char *SCORE_GLYPHS = "Score: 0123456789-";
 
 //Music constants
 const char *BACKGROUND_MUSIC_PATH = "assets/background_music.wav";
@@ -102,4 +110,11 @@ const char *BREAKING_PLATFORM_SOUND_PATH = "assets/breaking_platform.wav";
 const char *PLATFORM_BOUNCE_SOUND_PATH = "assets/platform_bounce.wav";
 const char *VILLAIN_SPAWN_SOUND_PATH = "assets/villain_spawn.wav";
 const char *GAME_OVER_SOUND_PATH = "assets/game_over.wav";
-const char *USER_DEATH_SOUND_PATH = "assets/user_death.wav";
\ No newline at end of file
+const char *USER_DEATH_SOUND_PATH = "assets/user_death.wav";
+
+// every sound effect path above, decoded by sound_bank_init()
+const char **const SOUND_PATHS[] = {
+    &BULLET_SOUND_PATH,        &BREAKING_PLATFORM_SOUND_PATH,
+    &PLATFORM_BOUNCE_SOUND_PATH, &VILLAIN_SPAWN_SOUND_PATH,
+    &GAME_OVER_SOUND_PATH,     &USER_DEATH_SOUND_PATH};
+const size_t NUM_SOUND_PATHS = sizeof(SOUND_PATHS) / sizeof(SOUND_PATHS[0]);
\ No newline at end of file
@@ -1,8 +1,14 @@
+#include "arena.h"
 #include "math.h"
+#include "platforms.h"
+#include "profiler.h"
 #include "sdl_wrapper.h"
+#include "sim.h"
 #include "state.h"
+#include "villain.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 
 #include <SDL2/SDL.h>
 #ifdef __EMSCRIPTEN__
@@ -33,7 +39,70 @@ void loop() {
   }
 }
 
-int main() {
+#ifdef HEADLESS
+/**
+ * Runs emscripten_main() for a fixed number of frames without a window
+ * and reports how long the simulation took.
+ */
+int main(int argc, char *argv[]) {
+  sim_options_t opts = sim_parse_args(argc, argv);
+#ifdef PROFILE
+  // Roughly twenty zones per frame, with a few physics substeps
+  profiler_init(opts.steps * 64);
+#else
+  if (opts.trace_path != NULL) {
+    fprintf(stderr, "--trace needs a profiling build ('make profile')\n");
+  }
+#endif
+  state = emscripten_init();
+
+  clock_t start = clock();
+  for (size_t i = 0; i < opts.steps; i++) {
+    emscripten_main(state);
+    sdl_is_done((void *)state);
+  }
+  double elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  sdl_stats_t stats = sdl_get_stats();
+  printf("steps %zu seed %u seconds %f frames_per_second %f\n", opts.steps,
+         opts.seed, elapsed, elapsed > 0 ? opts.steps / elapsed : 0.0);
+  printf("presents %zu draw_calls %zu bodies_drawn %zu images_rendered %zu "
+         "texts_rendered %zu sounds_played %zu\n",
+         stats.presents, stats.draw_calls, stats.bodies_drawn,
+         stats.images_rendered, stats.texts_rendered, stats.sounds_played);
+  sdl_stats_t last_frame = sdl_get_frame_stats();
+  size_t steps = opts.steps > 0 ? opts.steps : 1;
+  printf("presents_per_frame %f draw_calls_per_frame %f "
+         "last_frame_draw_calls %zu\n",
+         (double)stats.presents / steps, (double)stats.draw_calls / steps,
+         last_frame.draw_calls);
+  platform_pool_stats_t pool_stats = platform_pool_get_stats();
+  printf("platforms_created %zu platforms_reused %zu platforms_live %zu\n",
+         pool_stats.created, pool_stats.reused, pool_stats.live);
+  bullet_pool_stats_t bullet_stats = bullet_pool_get_stats();
+  printf("bullets_spawned %zu bullets_dropped %zu bullets_live %zu\n",
+         bullet_stats.spawned, bullet_stats.dropped, bullet_stats.live);
+  arena_stats_t arena_stats = arena_get_stats(frame_arena());
+  size_t frames = arena_stats.resets > 0 ? arena_stats.resets : 1;
+  printf("frame_allocs_per_frame %f frame_bytes_peak %zu "
+         "frame_arena_heap_allocs %zu\n",
+         (double)arena_stats.allocations / frames, arena_stats.peak_bytes,
+         arena_stats.heap_allocations);
+#ifdef PROFILE
+  profiler_write_summary(stdout);
+  if (opts.trace_path != NULL && !profiler_write_trace(opts.trace_path)) {
+    fprintf(stderr, "Couldn't write trace %s\n", opts.trace_path);
+  }
+  profiler_free();
+#endif
+
+  emscripten_free(state);
+  return 0;
+}
+#else
+int main(int argc, char *argv[]) {
+  // Allows --seed, --record and --replay when built from source
+  sim_parse_args(argc, argv);
 #ifdef __EMSCRIPTEN__
   // Set loop as the function emscripten calls to request a new frame
   emscripten_set_main_loop_arg(loop, NULL, 0, 1);
@@ -43,3 +112,4 @@ int main() {
   }
 #endif
 }
+#endif
@@ -0,0 +1,191 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "entity.h"
+#include "ptr_map.h"
+
+const size_t ENTITY_INIT_CAPACITY = 32;
+const entity_handle_t ENTITY_NO_HANDLE = {.index = UINT32_MAX,
+                                          .generation = 0};
+
+static const entity_info_t ENTITY_INFOS[NUM_ENTITY_KINDS] = {
+    [ENTITY_USER] = {ENTITY_USER, CATEGORY_PLAYER, "user"},
+    [ENTITY_VILLAIN] = {ENTITY_VILLAIN, CATEGORY_ENEMY, "villain"},
+    [ENTITY_BULLET] = {ENTITY_BULLET, CATEGORY_ENEMY | CATEGORY_PROJECTILE,
+                       "bullet"},
+    [ENTITY_STEADY_PLATFORM] = {ENTITY_STEADY_PLATFORM,
+                                CATEGORY_PLATFORM | CATEGORY_LANDABLE,
+                                "steady"},
+    [ENTITY_MOVING_PLATFORM] = {ENTITY_MOVING_PLATFORM,
+                                CATEGORY_PLATFORM | CATEGORY_LANDABLE,
+                                "moving"},
+    [ENTITY_BREAKING_PLATFORM] = {ENTITY_BREAKING_PLATFORM, CATEGORY_PLATFORM,
+                                  "breaking"},
+    [ENTITY_BROKEN_PLATFORM] = {ENTITY_BROKEN_PLATFORM, CATEGORY_PLATFORM,
+                                "broken"},
+};
+
+/**
+ * A slot in the handle table. A free slot has a NULL body and holds the
+ * index of the next free slot in `position`.
+ */
+typedef struct {
+  body_t *body;
+  uint32_t generation;
+  /** The body's position in its kind's array */
+  size_t position;
+} slot_t;
+
+/**
+ * A dense array of the slot indices of one kind's bodies.
+ */
+typedef struct {
+  uint32_t *slots;
+  size_t size;
+  size_t capacity;
+} kind_array_t;
+
+static slot_t *slots = NULL;
+static size_t num_slots = 0;
+static size_t slot_capacity = 0;
+static size_t free_slot = SIZE_MAX;
+
+static kind_array_t kinds[NUM_ENTITY_KINDS];
+
+/**
+ * Maps each body to the index of its slot.
+ */
+static ptr_map_t *body_slots = NULL;
+
+void *entity_info(entity_kind_t kind) {
+  assert(kind < NUM_ENTITY_KINDS);
+  return (void *)&ENTITY_INFOS[kind];
+}
+
+entity_kind_t entity_get_kind(body_t *body) {
+  entity_info_t *info = body_get_info(body);
+  assert(info != NULL);
+  return info->kind;
+}
+
+bool entity_in_category(body_t *body, uint32_t categories) {
+  entity_info_t *info = body_get_info(body);
+  return info != NULL && (info->categories & categories) != 0;
+}
+
+void entity_lists_init(void) {
+  slot_capacity = ENTITY_INIT_CAPACITY;
+  slots = malloc(sizeof(slot_t) * slot_capacity);
+  assert(slots != NULL);
+  num_slots = 0;
+  free_slot = SIZE_MAX;
+
+  body_slots = ptr_map_init(ENTITY_INIT_CAPACITY);
+
+  for (size_t i = 0; i < NUM_ENTITY_KINDS; i++) {
+    kinds[i] = (kind_array_t){
+        .slots = malloc(sizeof(uint32_t) * ENTITY_INIT_CAPACITY),
+        .size = 0,
+        .capacity = ENTITY_INIT_CAPACITY};
+    assert(kinds[i].slots != NULL);
+  }
+}
+
+void entity_lists_free(void) {
+  for (size_t i = 0; i < NUM_ENTITY_KINDS; i++) {
+    free(kinds[i].slots);
+    kinds[i] = (kind_array_t){0};
+  }
+  free(slots);
+  slots = NULL;
+  ptr_map_free(body_slots);
+  body_slots = NULL;
+}
+
+/** Takes a slot from the free list, or appends a new one */
+static uint32_t slot_alloc(void) {
+  if (free_slot != SIZE_MAX) {
+    uint32_t slot = free_slot;
+    free_slot = slots[slot].position;
+    return slot;
+  }
+  if (num_slots == slot_capacity) {
+    slot_capacity *= 2;
+    slots = realloc(slots, sizeof(slot_t) * slot_capacity);
+    assert(slots != NULL);
+  }
+  slots[num_slots].generation = 0;
+  return num_slots++;
+}
+
+entity_handle_t entity_add(scene_t *scene, body_t *body) {
+  scene_add_body(scene, body);
+  return entity_track(body);
+}
+
+entity_handle_t entity_track(body_t *body) {
+  kind_array_t *kind = &kinds[entity_get_kind(body)];
+  if (kind->size == kind->capacity) {
+    kind->capacity *= 2;
+    kind->slots = realloc(kind->slots, sizeof(uint32_t) * kind->capacity);
+    assert(kind->slots != NULL);
+  }
+
+  uint32_t slot = slot_alloc();
+  slots[slot].body = body;
+  slots[slot].position = kind->size;
+  kind->slots[kind->size++] = slot;
+  ptr_map_put(body_slots, body, (void *)(uintptr_t)slot);
+  return (entity_handle_t){.index = slot, .generation = slots[slot].generation};
+}
+
+body_t *entity_get_body(entity_handle_t handle) {
+  if (handle.index >= num_slots) {
+    return NULL;
+  }
+  slot_t *slot = &slots[handle.index];
+  return slot->generation == handle.generation ? slot->body : NULL;
+}
+
+/** Returns the handle of a body added with entity_add() in O(1) */
+static entity_handle_t entity_find(body_t *body) {
+  void *slot;
+  bool found = ptr_map_get(body_slots, body, &slot);
+  assert(found);
+  uint32_t index = (uintptr_t)slot;
+  return (entity_handle_t){.index = index,
+                           .generation = slots[index].generation};
+}
+
+void entity_untrack(body_t *body) {
+  uint32_t slot = entity_find(body).index;
+  kind_array_t *kind = &kinds[entity_get_kind(body)];
+
+  // Swap the last body of the kind into the removed body's position
+  size_t position = slots[slot].position;
+  uint32_t last = kind->slots[--kind->size];
+  kind->slots[position] = last;
+  slots[last].position = position;
+
+  ptr_map_remove(body_slots, body);
+  slots[slot].body = NULL;
+  slots[slot].generation++;
+  slots[slot].position = free_slot;
+  free_slot = slot;
+}
+
+void entity_remove(body_t *body) {
+  entity_untrack(body);
+  body_remove(body);
+}
+
+size_t entity_count(entity_kind_t kind) {
+  assert(kind < NUM_ENTITY_KINDS);
+  return kinds[kind].size;
+}
+
+body_t *entity_get(entity_kind_t kind, size_t i) {
+  assert(kind < NUM_ENTITY_KINDS);
+  assert(i < kinds[kind].size);
+  return slots[kinds[kind].slots[i]].body;
+}
@@ -0,0 +1,164 @@
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+#include "forces.h"
+
+/** Gravity isn't applied between bodies closer than this */
+const double GRAVITY_MIN_DISTANCE = 5.0;
+
+/** A force constant and the bodies it acts between */
+typedef struct {
+  double constant;
+  body_t *body1;
+  body_t *body2;
+} force_aux_t;
+
+/** The state of a collision force creator */
+typedef struct {
+  collision_handler_t handler;
+  void *aux;
+  free_func_t aux_freer;
+  double force_const;
+  /** Whether the bodies were colliding on the last tick */
+  bool colliding;
+} collision_aux_t;
+
+static force_aux_t *force_aux_init(double constant, body_t *body1,
+                                   body_t *body2) {
+  force_aux_t *aux = malloc(sizeof(force_aux_t));
+  assert(aux != NULL);
+  *aux = (force_aux_t){.constant = constant, .body1 = body1, .body2 = body2};
+  return aux;
+}
+
+/** Returns a list of the bodies a force creator acts on, which it doesn't own */
+static list_t *body_list(body_t *body1, body_t *body2) {
+  list_t *bodies = list_init(2, NULL);
+  list_add(bodies, body1);
+  if (body2 != NULL) {
+    list_add(bodies, body2);
+  }
+  return bodies;
+}
+
+static void newtonian_gravity(void *aux, list_t *bodies) {
+  force_aux_t *gravity = aux;
+  vector_t r = vec_subtract(body_get_centroid(gravity->body2),
+                            body_get_centroid(gravity->body1));
+  double distance = vec_get_length(r);
+  if (distance < GRAVITY_MIN_DISTANCE) {
+    return;
+  }
+  double magnitude = gravity->constant * body_get_mass(gravity->body1) *
+                     body_get_mass(gravity->body2) /
+                     (distance * distance * distance);
+  vector_t force = vec_multiply(magnitude, r);
+  body_add_force(gravity->body1, force);
+  body_add_force(gravity->body2, vec_negate(force));
+}
+
+void create_newtonian_gravity(scene_t *scene, double G, body_t *body1,
+                              body_t *body2) {
+  scene_add_force_creator(scene, newtonian_gravity,
+                          force_aux_init(G, body1, body2),
+                          body_list(body1, body2), free);
+}
+
+static void spring(void *aux, list_t *bodies) {
+  force_aux_t *spring = aux;
+  vector_t stretch = vec_subtract(body_get_centroid(spring->body2),
+                                  body_get_centroid(spring->body1));
+  vector_t force = vec_multiply(spring->constant, stretch);
+  body_add_force(spring->body1, force);
+  body_add_force(spring->body2, vec_negate(force));
+}
+
+void create_spring(scene_t *scene, double k, body_t *body1, body_t *body2) {
+  scene_add_force_creator(scene, spring, force_aux_init(k, body1, body2),
+                          body_list(body1, body2), free);
+}
+
+static void drag(void *aux, list_t *bodies) {
+  force_aux_t *drag = aux;
+  vector_t velocity = body_get_velocity(drag->body1);
+  body_add_force(drag->body1, vec_multiply(-drag->constant, velocity));
+}
+
+void create_drag(scene_t *scene, double gamma, body_t *body) {
+  scene_add_force_creator(scene, drag, force_aux_init(gamma, body, NULL),
+                          body_list(body, NULL), free);
+}
+
+static void collision_aux_free(collision_aux_t *collision) {
+  if (collision->aux_freer != NULL) {
+    collision->aux_freer(collision->aux);
+  }
+  free(collision);
+}
+
+static void collision(void *aux, list_t *bodies) {
+  collision_aux_t *collision = aux;
+  body_t *body1 = list_get(bodies, 0);
+  body_t *body2 = list_get(bodies, 1);
+  collision_info_t info = find_collision(body1, body2);
+  // Only call the handler when the bodies start colliding
+  if (info.collided && !collision->colliding) {
+    collision->handler(body1, body2, info.axis, collision->aux,
+                       collision->force_const);
+  }
+  collision->colliding = info.collided;
+}
+
+void create_collision(scene_t *scene, body_t *body1, body_t *body2,
+                      collision_handler_t handler, void *aux,
+                      double force_const, free_func_t freer) {
+  collision_aux_t *collision_aux = malloc(sizeof(collision_aux_t));
+  assert(collision_aux != NULL);
+  *collision_aux = (collision_aux_t){.handler = handler,
+                                     .aux = aux,
+                                     .aux_freer = freer,
+                                     .force_const = force_const,
+                                     .colliding = false};
+  scene_add_force_creator(scene, collision, collision_aux,
+                          body_list(body1, body2),
+                          (free_func_t)collision_aux_free);
+}
+
+static void destroy_both(body_t *body1, body_t *body2, vector_t axis,
+                         void *aux, double force_const) {
+  body_remove(body1);
+  body_remove(body2);
+}
+
+void create_destructive_collision(scene_t *scene, body_t *body1,
+                                  body_t *body2) {
+  create_collision(scene, body1, body2, destroy_both, NULL, 0, NULL);
+}
+
+static void physics_collision(body_t *body1, body_t *body2, vector_t axis,
+                              void *aux, double elasticity) {
+  double mass1 = body_get_mass(body1);
+  double mass2 = body_get_mass(body2);
+  // A wall (infinite mass) takes the whole impulse without moving
+  double reduced_mass;
+  if (mass1 == INFINITY) {
+    reduced_mass = mass2;
+  } else if (mass2 == INFINITY) {
+    reduced_mass = mass1;
+  } else {
+    reduced_mass = mass1 * mass2 / (mass1 + mass2);
+  }
+  double u1 = vec_dot(body_get_velocity(body1), axis);
+  double u2 = vec_dot(body_get_velocity(body2), axis);
+  vector_t impulse =
+      vec_multiply(reduced_mass * (1 + elasticity) * (u2 - u1), axis);
+  body_add_impulse(body1, impulse);
+  body_add_impulse(body2, vec_negate(impulse));
+}
+
+void create_physics_collision(scene_t *scene, body_t *body1, body_t *body2,
+                              double elasticity) {
+  create_collision(scene, body1, body2, physics_collision, NULL, elasticity,
+                   NULL);
+}
@@ -0,0 +1,99 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "list.h"
+
+const size_t LIST_GROWTH_FACTOR = 2;
+
+struct list {
+  void **data;
+  size_t size;
+  size_t capacity;
+  free_func_t freer;
+};
+
+list_t *list_init(size_t initial_capacity, free_func_t freer) {
+  assert(initial_capacity > 0);
+  list_t *list = malloc(sizeof(list_t));
+  assert(list != NULL);
+  list->data = malloc(sizeof(void *) * initial_capacity);
+  assert(list->data != NULL);
+  list->size = 0;
+  list->capacity = initial_capacity;
+  list->freer = freer;
+  return list;
+}
+
+void list_free(list_t *list) {
+  list_clear(list);
+  free(list->data);
+  free(list);
+}
+
+size_t list_size(list_t *list) { return list->size; }
+
+void *list_get(list_t *list, size_t index) {
+  assert(index < list->size);
+  return list->data[index];
+}
+
+void list_reserve(list_t *list, size_t capacity) {
+  if (capacity <= list->capacity) {
+    return;
+  }
+  list->data = realloc(list->data, sizeof(void *) * capacity);
+  assert(list->data != NULL);
+  list->capacity = capacity;
+}
+
+void list_add(list_t *list, void *value) {
+  assert(value != NULL);
+  if (list->size == list->capacity) {
+    list_reserve(list, list->capacity * LIST_GROWTH_FACTOR);
+  }
+  list->data[list->size++] = value;
+}
+
+void *list_remove(list_t *list, size_t index) {
+  assert(index < list->size);
+  void *value = list->data[index];
+  for (size_t i = index + 1; i < list->size; i++) {
+    list->data[i - 1] = list->data[i];
+  }
+  list->size--;
+  return value;
+}
+
+void *list_swap_remove(list_t *list, size_t index) {
+  assert(index < list->size);
+  void *value = list->data[index];
+  list->data[index] = list->data[--list->size];
+  return value;
+}
+
+size_t list_remove_if(list_t *list, list_predicate_t predicate, void *aux) {
+  // Kept elements are moved down over the removed ones as the pass goes
+  size_t kept = 0;
+  for (size_t i = 0; i < list->size; i++) {
+    void *value = list->data[i];
+    if (predicate(value, aux)) {
+      if (list->freer != NULL) {
+        list->freer(value);
+      }
+    } else {
+      list->data[kept++] = value;
+    }
+  }
+  size_t removed = list->size - kept;
+  list->size = kept;
+  return removed;
+}
+
+void list_clear(list_t *list) {
+  if (list->freer != NULL) {
+    for (size_t i = 0; i < list->size; i++) {
+      list->freer(list->data[i]);
+    }
+  }
+  list->size = 0;
+}
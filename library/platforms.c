@@ -9,7 +9,179 @@
 #include "asset_cache.h"
 #include "game_util.h"
 #include "constants.h"
+#include "entity.h"
+#include "platforms.h"
+#include "shape_template.h"
 
+typedef struct {
+  double top;
+  body_t *body;
+} index_entry_t;
+
+struct platform_index {
+  index_entry_t *entries;
+  size_t size;
+  size_t capacity;
+};
+
+platform_index_t *platform_index_init(size_t initial_capacity) {
+  platform_index_t *index = malloc(sizeof(platform_index_t));
+  assert(index != NULL);
+  index->capacity = initial_capacity > 0 ? initial_capacity : 1;
+  index->size = 0;
+  index->entries = malloc(sizeof(index_entry_t) * index->capacity);
+  assert(index->entries != NULL);
+  return index;
+}
+
+void platform_index_free(platform_index_t *index) {
+  free(index->entries);
+  free(index);
+}
+
+size_t platform_index_size(platform_index_t *index) { return index->size; }
+
+body_t *platform_index_get(platform_index_t *index, size_t i) {
+  assert(i < index->size);
+  return index->entries[i].body;
+}
+
+double platform_index_top(platform_index_t *index, size_t i) {
+  assert(i < index->size);
+  return index->entries[i].top;
+}
+
+size_t platform_index_lower_bound(platform_index_t *index, double top_y) {
+  size_t low = 0, high = index->size;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (index->entries[mid].top < top_y) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+void platform_index_add(platform_index_t *index, body_t *platform) {
+  if (index->size == index->capacity) {
+    index->capacity *= 2;
+    index->entries =
+        realloc(index->entries, sizeof(index_entry_t) * index->capacity);
+    assert(index->entries != NULL);
+  }
+  double top = body_get_centroid(platform).y + PLATFORM_HEIGHT / 2.0;
+  // Insert after any platforms at the same height, so insertion order is kept
+  size_t i = platform_index_lower_bound(index, nextafter(top, INFINITY));
+  memmove(&index->entries[i + 1], &index->entries[i],
+          sizeof(index_entry_t) * (index->size - i));
+  index->entries[i] = (index_entry_t){.top = top, .body = platform};
+  index->size++;
+}
+
+void platform_index_remove(platform_index_t *index, size_t i) {
+  assert(i < index->size);
+  index->size--;
+  memmove(&index->entries[i], &index->entries[i + 1],
+          sizeof(index_entry_t) * (index->size - i));
+}
+
+void platform_index_remove_lowest(platform_index_t *index, size_t count) {
+  assert(count <= index->size);
+  index->size -= count;
+  memmove(index->entries, &index->entries[count],
+          sizeof(index_entry_t) * index->size);
+}
+
+/**
+ * Where released platforms wait, far below anything the camera can see.
+ */
+static const vector_t PARKED_POSITION = {0, -1e9};
+
+/**
+ * The released platforms of one kind, and how many of the kind exist.
+ */
+typedef struct {
+  body_t **free;
+  size_t num_free;
+  size_t num_created;
+} kind_pool_t;
+
+static scene_t *pool_scene = NULL;
+static kind_pool_t pools[NUM_ENTITY_KINDS];
+static platform_pool_stats_t pool_stats;
+
+static const char *platform_image(entity_kind_t kind) {
+  switch (kind) {
+    case ENTITY_STEADY_PLATFORM:
+      return STEADY_PLATFORM_PATH;
+    case ENTITY_MOVING_PLATFORM:
+      return MOVING_PLATFORM_PATH;
+    case ENTITY_BREAKING_PLATFORM:
+      return BREAKING_PLATFORM_PATH;
+    case ENTITY_BROKEN_PLATFORM:
+      return PLATFORM_BROKE;
+    default:
+      assert(false && "not a platform kind");
+      return NULL;
+  }
+}
+
+void platform_pool_init(scene_t *scene) {
+  pool_scene = scene;
+  pool_stats = (platform_pool_stats_t){0};
+  for (size_t i = 0; i < NUM_ENTITY_KINDS; i++) {
+    pools[i] = (kind_pool_t){0};
+  }
+}
+
+void platform_pool_free(void) {
+  for (size_t i = 0; i < NUM_ENTITY_KINDS; i++) {
+    free(pools[i].free);
+    pools[i] = (kind_pool_t){0};
+  }
+  pool_scene = NULL;
+}
+
+body_t *platform_pool_acquire(entity_kind_t kind, vector_t center) {
+  kind_pool_t *pool = &pools[kind];
+  body_t *platform;
+  if (pool->num_free > 0) {
+    platform = pool->free[--pool->num_free];
+    body_set_centroid(platform, center);
+    entity_track(platform);
+    pool_stats.reused++;
+  } else {
+    // platforms_init() adds the first platform on top of TOTAL_PLATFORMS
+    size_t capacity = TOTAL_PLATFORMS + 1;
+    assert(pool->num_created < capacity);
+    if (pool->free == NULL) {
+      // Room for every platform of the kind, so releasing never allocates
+      pool->free = malloc(sizeof(body_t *) * capacity);
+      assert(pool->free != NULL);
+    }
+    platform = make_platform(PLATFORM_WIDTH, PLATFORM_HEIGHT, center, kind);
+    entity_add(pool_scene, platform);
+    asset_make_image_with_body(platform_image(kind), platform);
+    pool->num_created++;
+    pool_stats.created++;
+  }
+  pool_stats.live++;
+  return platform;
+}
+
+void platform_pool_release(body_t *platform) {
+  kind_pool_t *pool = &pools[entity_get_kind(platform)];
+  assert(pool->num_free < pool->num_created);
+  entity_untrack(platform);
+  body_set_velocity(platform, VEC_ZERO);
+  body_set_centroid(platform, PARKED_POSITION);
+  pool->free[pool->num_free++] = platform;
+  pool_stats.live--;
+}
+
+platform_pool_stats_t platform_pool_get_stats(void) { return pool_stats; }
 
 /**
  * Returns the body of a platform.
@@ -20,43 +192,27 @@
  * @param platform_info what type of platform - steady, moving, breaking
  * @return body_t of the platform
  */
-body_t *make_platform(size_t w, size_t h, vector_t center, const char *platform_info) {
-  list_t *c = list_init(4, free);
-  vector_t *v1 = malloc(sizeof(vector_t));
-  *v1 = (vector_t){0, 0};
-  list_add(c, v1);
-
-  vector_t *v2 = malloc(sizeof(vector_t));
-  *v2 = (vector_t){w, 0};
-  list_add(c, v2);
-
-  vector_t *v3 = malloc(sizeof(vector_t));
-  *v3 = (vector_t){w, h};
-  list_add(c, v3);
-
-  vector_t *v4 = malloc(sizeof(vector_t));
-  *v4 = (vector_t){0, h};
-  list_add(c, v4);
-  body_t *obstacle = body_init_with_info(c, 1, OBS_COLOR, (void *)platform_info, NULL);
-  body_set_centroid(obstacle, center);
+body_t *make_platform(size_t w, size_t h, vector_t center, entity_kind_t kind) {
+  list_t *c = shape_template_instantiate(shape_template_rect(w, h), center);
+  body_t *obstacle = body_init_with_info(c, 1, OBS_COLOR, entity_info(kind), NULL);
   return obstacle;
 }
 
 /**
- * Returns the info of a platform
+ * Returns the kind of a platform
  *
- * @return the info of the platform
+ * @return the kind of the platform
  */
-const char *platform_select() {
+entity_kind_t platform_select() {
   float r = (float)rand() / (float)RAND_MAX;
   if (r < PCT_MOVING) {
-    return MOVING_PLATFORM_INFO;
+    return ENTITY_MOVING_PLATFORM;
   }
   else if (r < PCT_MOVING + PCT_STEADY) {
-    return STEADY_PLATFORM_INFO;
+    return ENTITY_STEADY_PLATFORM;
   }
   else {
-    return BREAKING_PLATFORM_INFO;
+    return ENTITY_BREAKING_PLATFORM;
   }
 }
 
@@ -66,11 +222,9 @@ const char *platform_select() {
  * @param state the state 
  * @return void
  */
-void platforms_init(list_t *platforms_list, scene_t *scene) {
-  body_t *first_platform = make_platform(PLATFORM_WIDTH, PLATFORM_HEIGHT, FIRST_PLATFORM_LOC, STEADY_PLATFORM_INFO);
-  scene_add_body(scene, first_platform);
-  asset_make_image_with_body(STEADY_PLATFORM_PATH, first_platform);
-  list_add(platforms_list, first_platform);
+void platforms_init(platform_index_t *platforms, scene_t *scene) {
+  body_t *first_platform = platform_pool_acquire(ENTITY_STEADY_PLATFORM, FIRST_PLATFORM_LOC);
+  platform_index_add(platforms, first_platform);
 
   for (size_t i = 0; i < NUM_PLATFORM_CHANNELS; i++) {
     size_t y_min = CHANNEL_HEIGHT * i;
@@ -78,20 +232,12 @@ void platforms_init(list_t *platforms_list, scene_t *scene) {
     for (size_t i = 0; i < PLATFORMS_PER_CHANNEL; i++) {
       size_t x_position = (size_t)(((rand() / (double)RAND_MAX) * (MAX.x - PLATFORM_WIDTH)) + 0.5*PLATFORM_WIDTH);;
       size_t y_position = (size_t)(y_min + (rand() / (double)RAND_MAX) * (y_max - y_min));
-      const char *platform_type = platform_select();
-      body_t *platform = make_platform(PLATFORM_WIDTH, PLATFORM_HEIGHT, (vector_t){x_position, y_position}, platform_type);
-      scene_add_body(scene, platform);
-      if (strcmp(platform_type, STEADY_PLATFORM_INFO) == 0) {
-        asset_make_image_with_body(STEADY_PLATFORM_PATH, platform);
-      } 
-      else if (strcmp(platform_type, BREAKING_PLATFORM_INFO) == 0) {
-        asset_make_image_with_body(BREAKING_PLATFORM_PATH, platform);
-      } 
-      else if (strcmp(platform_type, MOVING_PLATFORM_INFO) == 0) {
-        asset_make_image_with_body(MOVING_PLATFORM_PATH, platform);
+      entity_kind_t platform_type = platform_select();
+      body_t *platform = platform_pool_acquire(platform_type, (vector_t){x_position, y_position});
+      if (platform_type == ENTITY_MOVING_PLATFORM) {
         body_set_velocity(platform, BASE_OBJ_VEL);
       }
-      list_add(platforms_list, platform);
+      platform_index_add(platforms, platform);
     }
   }
 }
@@ -100,37 +246,31 @@ void platforms_init(list_t *platforms_list, scene_t *scene) {
  * Creates platforms to replace the platforms that go off the bottom of the screen when the screen moves.
  *
  * @param state the state 
+ * @param camera_y the world height of the bottom of the view
  * @return void
  */
-void screen_move_platforms_create(list_t *platforms_list, scene_t *scene, int16_t score) {
-  double max_platform_y = MIN.y;
-  size_t n = list_size(platforms_list);
-  for (size_t i = 0; i < n; i++) {
-    body_t *platform = list_get(platforms_list, i);
-    size_t plat_y_coord = body_get_centroid(platform).y;
+void screen_move_platforms_create(platform_index_t *platforms, scene_t *scene, int16_t score, double camera_y) {
+  double max_platform_y = camera_y + MIN.y;
+  size_t num_platforms = platform_index_size(platforms);
+  if (num_platforms > 0) {
+    // The highest platform is the last one in the index
+    body_t *highest = platform_index_get(platforms, num_platforms - 1);
+    size_t plat_y_coord = body_get_centroid(highest).y;
     if (plat_y_coord > max_platform_y) {
       max_platform_y = plat_y_coord;
     }
   }
-  size_t num_platforms = list_size(platforms_list);
   if (num_platforms < TOTAL_PLATFORMS) {
     size_t NUM_NEW_PLATFORMS = TOTAL_PLATFORMS - num_platforms;
     for (size_t i = 0; i < NUM_NEW_PLATFORMS; i++) {
-      const char *plat_info = platform_select();
+      entity_kind_t plat_kind = platform_select();
       size_t x_position = (size_t)(((rand() / (double)RAND_MAX) * (MAX.x - PLATFORM_WIDTH)) + 0.5*PLATFORM_WIDTH);
-      size_t y_position = (size_t)(max_platform_y + (rand() / (double)RAND_MAX) * (MAX.y - max_platform_y));
-      body_t *new_platform = make_platform(PLATFORM_WIDTH, PLATFORM_HEIGHT, (vector_t){x_position, y_position}, plat_info);
-      scene_add_body(scene, new_platform);
-
-      if (strcmp(plat_info, STEADY_PLATFORM_INFO) == 0) {
-        asset_make_image_with_body(STEADY_PLATFORM_PATH, new_platform);
-      } else if (strcmp(plat_info, BREAKING_PLATFORM_INFO) == 0) {
-        asset_make_image_with_body(BREAKING_PLATFORM_PATH, new_platform);
-      } else if (strcmp(plat_info, MOVING_PLATFORM_INFO) == 0) {
-        asset_make_image_with_body(MOVING_PLATFORM_PATH, new_platform);
+      size_t y_position = (size_t)(max_platform_y + (rand() / (double)RAND_MAX) * (camera_y + MAX.y - max_platform_y));
+      body_t *new_platform = platform_pool_acquire(plat_kind, (vector_t){x_position, y_position});
+      if (plat_kind == ENTITY_MOVING_PLATFORM) {
         body_set_velocity(new_platform, vec_multiply((double)(score / 2000) ,BASE_OBJ_VEL));
       }
-      list_add(platforms_list, new_platform);
+      platform_index_add(platforms, new_platform);
     }
   }
 }
@@ -139,38 +279,37 @@ void screen_move_platforms_create(list_t *platforms_list, scene_t *scene, int16_
  * Removes platforms that leave the screen when the screen moves up.
  *
  * @param state the state 
+ * @param camera_y the world height of the bottom of the view
  * @return void
  */
-void remove_platform(list_t *platforms_list, scene_t *scene) {
-  ssize_t platform_count = list_size(platforms_list);
-  for (ssize_t i = 0; i < platform_count; i++) {
-    body_t *platform = list_get(platforms_list, i);
+void remove_platform(platform_index_t *platforms, scene_t *scene, double camera_y) {
+  // Platforms below the view are always at the start of the index
+  size_t platform_count = platform_index_size(platforms);
+  size_t removed = 0;
+  while (removed < platform_count) {
+    body_t *platform = platform_index_get(platforms, removed);
     double y = body_get_centroid(platform).y;
-    if (y <= MIN.y) {
-      scene_remove_body(scene, body_index_in_scene(scene, platform));
-      list_remove(platforms_list, i);
-      platform_count--;
-      i--;
-    } 
+    if (y > camera_y + MIN.y) {
+      break;
+    }
+    platform_pool_release(platform);
+    removed++;
   }
-
+  platform_index_remove_lowest(platforms, removed);
 }
 
 /**
- * Bounces the platforms off the sides of the screen when they reach them.
+ * Bounces the moving platforms off the sides of the screen when they reach them.
  *
- * @param state the state 
  * @return void
  */
-void platforms_bounce_off_wall(scene_t *scene) {
-  size_t n = scene_bodies(scene);
+void platforms_bounce_off_wall(void) {
+  size_t n = entity_count(ENTITY_MOVING_PLATFORM);
   for (size_t i = 0; i < n; i++) {
-    body_t *body = scene_get_body(scene, i);
-    if (body_get_info(body) && strcmp(body_get_info(body), MOVING_PLATFORM_INFO) == 0) {
-      if (body_get_centroid(body).x + PLATFORM_WIDTH/2.0 >= MAX.x || body_get_centroid(body).x - PLATFORM_WIDTH/2.0 <= MIN.x) {
-        vector_t vel = body_get_velocity(body);
-        body_set_velocity(body, vec_multiply(-1, vel));
-      }
+    body_t *body = entity_get(ENTITY_MOVING_PLATFORM, i);
+    if (body_get_centroid(body).x + PLATFORM_WIDTH/2.0 >= MAX.x || body_get_centroid(body).x - PLATFORM_WIDTH/2.0 <= MIN.x) {
+      vector_t vel = body_get_velocity(body);
+      body_set_velocity(body, vec_multiply(-1, vel));
     }
   }
 }
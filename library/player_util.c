@@ -9,29 +9,8 @@
 #include "asset_cache.h"
 #include "game_util.h"
 #include "constants.h"
-
-
-/**
- * Starting dot used to calulate the distance traveled for the score
- *
- * @param center center/ where the dot is
- * @return body_t of the starting dot
- */
-body_t *start_dot(vector_t center){
-  const double DOT_RADIUS = 1.0;
-  const size_t NUM_POINTS = 12;
-
-  list_t *c = list_init(NUM_POINTS, free);
-  for (size_t i = 0; i < NUM_POINTS; i++){
-    double angle = 2 * M_PI * i / NUM_POINTS;
-    vector_t *v = malloc(sizeof(*v));
-    *v = (vector_t){center.x + DOT_RADIUS * cos(angle),
-                    center.y + DOT_RADIUS * sin(angle)};
-    list_add(c, v);
-  }
-  body_t *dot = body_init(c, 1, USER_COLOR);
-  return dot;
-}
+#include "entity.h"
+#include "shape_template.h"
 
 /**
  * make the doodler body
@@ -43,15 +22,10 @@ body_t *start_dot(vector_t center){
  */
 body_t *make_user(double outer_radius, double inner_radius, vector_t center) {
   center.y += inner_radius;
-  list_t *c = list_init(USER_NUM_POINTS, free);
-  for (size_t i = 0; i < USER_NUM_POINTS; i++) {
-    double angle = 2 * M_PI * i / USER_NUM_POINTS;
-    vector_t *v = malloc(sizeof(*v));
-    *v = (vector_t){center.x + inner_radius * cos(angle),
-                    center.y + outer_radius * sin(angle)};
-    list_add(c, v);
-  }
-  body_t *user = body_init(c, 1, USER_COLOR);
+  list_t *c = shape_template_instantiate(
+      shape_template_ellipse(inner_radius, outer_radius, USER_NUM_POINTS),
+      center);
+  body_t *user = body_init_with_info(c, 1, USER_COLOR, entity_info(ENTITY_USER), NULL);
   return user;
 }
 
@@ -0,0 +1,157 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "profiler.h"
+
+const double NS_PER_US = 1000.0;
+
+/**
+ * A zone that has ended, with its times in nanoseconds since the profiler
+ * started.
+ */
+typedef struct {
+  const char *name;
+  uint64_t start_ns;
+  uint64_t duration_ns;
+} zone_record_t;
+
+static zone_record_t *zones = NULL;
+static size_t num_zones = 0;
+static size_t max_zones = 0;
+static size_t dropped_zones = 0;
+static uint64_t origin_ns = 0;
+
+static uint64_t now_ns(void) {
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return (uint64_t)time.tv_sec * 1000000000ull + time.tv_nsec;
+}
+
+void profiler_init(size_t capacity) {
+  assert(zones == NULL);
+  assert(capacity > 0);
+  zones = malloc(sizeof(zone_record_t) * capacity);
+  assert(zones != NULL);
+  num_zones = 0;
+  max_zones = capacity;
+  dropped_zones = 0;
+  origin_ns = now_ns();
+}
+
+void profiler_free(void) {
+  free(zones);
+  zones = NULL;
+  num_zones = 0;
+  max_zones = 0;
+}
+
+bool profiler_enabled(void) { return zones != NULL; }
+
+profile_zone_t profiler_zone_begin(const char *name) {
+  return (profile_zone_t){.name = name, .start_ns = now_ns()};
+}
+
+void profiler_zone_end(profile_zone_t *zone) {
+  uint64_t end_ns = now_ns();
+  if (zones == NULL) {
+    return;
+  }
+  if (num_zones == max_zones) {
+    dropped_zones++;
+    return;
+  }
+  zones[num_zones++] = (zone_record_t){.name = zone->name,
+                                       .start_ns = zone->start_ns - origin_ns,
+                                       .duration_ns = end_ns - zone->start_ns};
+}
+
+size_t profiler_zone_count(void) { return num_zones; }
+
+/** Writes a string as a JSON string literal */
+static void write_json_string(FILE *out, const char *string) {
+  fputc('"', out);
+  for (const char *c = string; *c != '\0'; c++) {
+    if (*c == '"' || *c == '\\') {
+      fputc('\\', out);
+    }
+    fputc(*c, out);
+  }
+  fputc('"', out);
+}
+
+bool profiler_write_trace(const char *path) {
+  FILE *out = fopen(path, "w");
+  if (out == NULL) {
+    return false;
+  }
+  fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  for (size_t i = 0; i < num_zones; i++) {
+    zone_record_t *zone = &zones[i];
+    fprintf(out, "{\"name\":");
+    write_json_string(out, zone->name);
+    fprintf(out, ",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}%s\n",
+            zone->start_ns / NS_PER_US, zone->duration_ns / NS_PER_US,
+            i + 1 < num_zones ? "," : "");
+  }
+  fprintf(out, "]}\n");
+  return fclose(out) == 0;
+}
+
+static int compare_durations(const void *a, const void *b) {
+  uint64_t x = *(const uint64_t *)a;
+  uint64_t y = *(const uint64_t *)b;
+  return (x > y) - (x < y);
+}
+
+/** Returns the sorted durations' value at a percentile, nearest rank */
+static double percentile_us(const uint64_t *sorted, size_t n, double percent) {
+  size_t rank = (size_t)(percent / 100 * n + 0.5);
+  size_t index = rank > 0 ? rank - 1 : 0;
+  if (index >= n) {
+    index = n - 1;
+  }
+  return sorted[index] / NS_PER_US;
+}
+
+void profiler_write_summary(FILE *out) {
+  fprintf(out, "%-32s %8s %12s %10s %10s %10s %10s %10s\n", "zone", "count",
+          "total_ms", "mean_us", "p50_us", "p90_us", "p99_us", "max_us");
+  if (num_zones == 0) {
+    return;
+  }
+  uint64_t *durations = malloc(sizeof(uint64_t) * num_zones);
+  bool *summarized = calloc(num_zones, sizeof(bool));
+  assert(durations != NULL);
+  assert(summarized != NULL);
+
+  // One pass per distinct name, in the order names first appear
+  for (size_t i = 0; i < num_zones; i++) {
+    if (summarized[i]) {
+      continue;
+    }
+    const char *name = zones[i].name;
+    size_t n = 0;
+    uint64_t total = 0;
+    for (size_t j = i; j < num_zones; j++) {
+      if (!summarized[j] &&
+          (zones[j].name == name || strcmp(zones[j].name, name) == 0)) {
+        summarized[j] = true;
+        durations[n++] = zones[j].duration_ns;
+        total += zones[j].duration_ns;
+      }
+    }
+    qsort(durations, n, sizeof(uint64_t), compare_durations);
+    fprintf(out, "%-32s %8zu %12.3f %10.3f %10.3f %10.3f %10.3f %10.3f\n",
+            name, n, total / (NS_PER_US * 1000), total / NS_PER_US / n,
+            percentile_us(durations, n, 50), percentile_us(durations, n, 90),
+            percentile_us(durations, n, 99), durations[n - 1] / NS_PER_US);
+  }
+  if (dropped_zones > 0) {
+    fprintf(out, "dropped %zu zones after the first %zu\n", dropped_zones,
+            max_zones);
+  }
+  free(durations);
+  free(summarized);
+}
@@ -0,0 +1,128 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "ptr_map.h"
+
+const size_t PTR_MAP_MIN_CAPACITY = 8;
+
+/**
+ * A slot of the table. Empty slots have a NULL key.
+ */
+typedef struct {
+  const void *key;
+  void *value;
+} ptr_entry_t;
+
+struct ptr_map {
+  ptr_entry_t *entries;
+  /** Always a power of two */
+  size_t capacity;
+  size_t size;
+};
+
+/** Fibonacci hashing of the key's address */
+static size_t home_slot(ptr_map_t *map, const void *key) {
+  uint64_t bits = (uint64_t)(uintptr_t)key * 11400714819323198485ull;
+  return (size_t)(bits >> 32) & (map->capacity - 1);
+}
+
+static ptr_entry_t *probe(ptr_map_t *map, const void *key) {
+  size_t mask = map->capacity - 1;
+  for (size_t i = home_slot(map, key);; i = (i + 1) & mask) {
+    ptr_entry_t *entry = &map->entries[i];
+    if (entry->key == NULL || entry->key == key) {
+      return entry;
+    }
+  }
+}
+
+static void alloc_entries(ptr_map_t *map, size_t capacity) {
+  map->capacity = capacity;
+  map->size = 0;
+  map->entries = calloc(capacity, sizeof(ptr_entry_t));
+  assert(map->entries != NULL);
+}
+
+ptr_map_t *ptr_map_init(size_t initial_capacity) {
+  ptr_map_t *map = malloc(sizeof(ptr_map_t));
+  assert(map != NULL);
+  // Keep the table at most half full
+  size_t capacity = PTR_MAP_MIN_CAPACITY;
+  while (capacity < initial_capacity * 2) {
+    capacity *= 2;
+  }
+  alloc_entries(map, capacity);
+  return map;
+}
+
+void ptr_map_free(ptr_map_t *map) {
+  free(map->entries);
+  free(map);
+}
+
+size_t ptr_map_size(ptr_map_t *map) { return map->size; }
+
+bool ptr_map_get(ptr_map_t *map, const void *key, void **value) {
+  assert(key != NULL);
+  ptr_entry_t *entry = probe(map, key);
+  if (entry->key == NULL) {
+    return false;
+  }
+  if (value != NULL) {
+    *value = entry->value;
+  }
+  return true;
+}
+
+/** Doubles the capacity once the table is half full */
+static void grow(ptr_map_t *map) {
+  ptr_entry_t *old = map->entries;
+  size_t old_capacity = map->capacity;
+  alloc_entries(map, old_capacity * 2);
+  for (size_t i = 0; i < old_capacity; i++) {
+    if (old[i].key != NULL) {
+      *probe(map, old[i].key) = old[i];
+      map->size++;
+    }
+  }
+  free(old);
+}
+
+void ptr_map_put(ptr_map_t *map, const void *key, void *value) {
+  assert(key != NULL);
+  ptr_entry_t *entry = probe(map, key);
+  if (entry->key == NULL) {
+    if ((map->size + 1) * 2 > map->capacity) {
+      grow(map);
+      entry = probe(map, key);
+    }
+    entry->key = key;
+    map->size++;
+  }
+  entry->value = value;
+}
+
+bool ptr_map_remove(ptr_map_t *map, const void *key) {
+  assert(key != NULL);
+  ptr_entry_t *entry = probe(map, key);
+  if (entry->key == NULL) {
+    return false;
+  }
+
+  // Shift later entries of the probe run back into the hole,
+  // unless their home slot lies between the hole and where they are
+  size_t mask = map->capacity - 1;
+  size_t hole = entry - map->entries;
+  for (size_t i = (hole + 1) & mask; map->entries[i].key != NULL;
+       i = (i + 1) & mask) {
+    size_t home = home_slot(map, map->entries[i].key);
+    if (((i - home) & mask) >= ((i - hole) & mask)) {
+      map->entries[hole] = map->entries[i];
+      hole = i;
+    }
+  }
+  map->entries[hole].key = NULL;
+  map->size--;
+  return true;
+}
@@ -0,0 +1,206 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "replay.h"
+
+const char REPLAY_MAGIC[4] = {'D', 'J', 'R', 'P'};
+const uint8_t REPLAY_VERSION = 1;
+const size_t REPLAY_INIT_CAPACITY = 64;
+
+/**
+ * The record tags that follow the file header.
+ * TICK holds a double frame time.
+ * KEY holds a uint32 frame, a key char, a uint8 event type and a double held
+ * time. END holds the uint32 frame count and is written by replay_stop().
+ */
+typedef enum {
+  REPLAY_TICK = 1,
+  REPLAY_KEY = 2,
+  REPLAY_END = 3,
+} replay_tag_t;
+
+typedef struct {
+  uint32_t frame;
+  char key;
+  key_event_type_t type;
+  double held_time;
+} key_record_t;
+
+/**
+ * The file being recorded to, or NULL if not recording.
+ */
+static FILE *record_file = NULL;
+/**
+ * The number of frames that have ended since the program started.
+ */
+static uint32_t frame = 0;
+
+/**
+ * The loaded recording.
+ */
+static key_record_t *keys = NULL;
+static size_t num_keys = 0;
+static size_t next_key = 0;
+static double *ticks = NULL;
+static size_t num_ticks = 0;
+static size_t next_tick = 0;
+static size_t num_frames = 0;
+
+static void write_field(const void *field, size_t size) {
+  fwrite(field, size, 1, record_file);
+}
+
+static bool read_field(FILE *file, void *field, size_t size) {
+  return fread(field, size, 1, file) == 1;
+}
+
+static void replay_fail(const char *path) {
+  fprintf(stderr, "Couldn't read replay %s\n", path);
+  exit(1);
+}
+
+void replay_start_recording(const char *path, unsigned int seed) {
+  assert(record_file == NULL);
+  record_file = fopen(path, "wb");
+  if (record_file == NULL) {
+    fprintf(stderr, "Couldn't create replay %s\n", path);
+    exit(1);
+  }
+  uint32_t seed32 = seed;
+  write_field(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+  write_field(&REPLAY_VERSION, sizeof(REPLAY_VERSION));
+  write_field(&seed32, sizeof(seed32));
+  atexit(replay_stop);
+}
+
+unsigned int replay_load(const char *path) {
+  FILE *file = fopen(path, "rb");
+  if (file == NULL) {
+    replay_fail(path);
+  }
+
+  char magic[sizeof(REPLAY_MAGIC)];
+  uint8_t version;
+  uint32_t seed;
+  if (!read_field(file, magic, sizeof(magic)) ||
+      memcmp(magic, REPLAY_MAGIC, sizeof(magic)) != 0 ||
+      !read_field(file, &version, sizeof(version)) ||
+      version != REPLAY_VERSION || !read_field(file, &seed, sizeof(seed))) {
+    replay_fail(path);
+  }
+
+  size_t key_capacity = REPLAY_INIT_CAPACITY;
+  size_t tick_capacity = REPLAY_INIT_CAPACITY;
+  keys = malloc(sizeof(*keys) * key_capacity);
+  ticks = malloc(sizeof(*ticks) * tick_capacity);
+  assert(keys != NULL);
+  assert(ticks != NULL);
+  num_keys = 0;
+  num_ticks = 0;
+  num_frames = 0;
+
+  uint8_t tag;
+  while (read_field(file, &tag, sizeof(tag))) {
+    if (tag == REPLAY_TICK) {
+      if (num_ticks == tick_capacity) {
+        tick_capacity *= 2;
+        ticks = realloc(ticks, sizeof(*ticks) * tick_capacity);
+        assert(ticks != NULL);
+      }
+      if (!read_field(file, &ticks[num_ticks], sizeof(double))) {
+        replay_fail(path);
+      }
+      num_ticks++;
+    } else if (tag == REPLAY_KEY) {
+      if (num_keys == key_capacity) {
+        key_capacity *= 2;
+        keys = realloc(keys, sizeof(*keys) * key_capacity);
+        assert(keys != NULL);
+      }
+      key_record_t *record = &keys[num_keys];
+      uint8_t type;
+      if (!read_field(file, &record->frame, sizeof(record->frame)) ||
+          !read_field(file, &record->key, sizeof(record->key)) ||
+          !read_field(file, &type, sizeof(type)) ||
+          !read_field(file, &record->held_time, sizeof(record->held_time))) {
+        replay_fail(path);
+      }
+      record->type = type;
+      num_keys++;
+    } else if (tag == REPLAY_END) {
+      uint32_t frames;
+      if (!read_field(file, &frames, sizeof(frames))) {
+        replay_fail(path);
+      }
+      num_frames = frames;
+    } else {
+      replay_fail(path);
+    }
+  }
+  fclose(file);
+
+  // A recording cut short by a crash has no END record;
+  // every frame asks for exactly one frame time.
+  if (num_frames == 0) {
+    num_frames = num_ticks;
+  }
+  next_key = 0;
+  next_tick = 0;
+  return seed;
+}
+
+bool replay_is_playing(void) { return next_tick < num_ticks; }
+
+size_t replay_frames(void) { return num_frames; }
+
+void replay_record_key(char key, key_event_type_t type, double held_time) {
+  if (record_file == NULL) {
+    return;
+  }
+  uint8_t tag = REPLAY_KEY;
+  uint8_t type8 = type;
+  write_field(&tag, sizeof(tag));
+  write_field(&frame, sizeof(frame));
+  write_field(&key, sizeof(key));
+  write_field(&type8, sizeof(type8));
+  write_field(&held_time, sizeof(held_time));
+}
+
+void replay_record_tick(double dt) {
+  if (record_file == NULL) {
+    return;
+  }
+  uint8_t tag = REPLAY_TICK;
+  write_field(&tag, sizeof(tag));
+  write_field(&dt, sizeof(dt));
+}
+
+double replay_next_tick(void) {
+  assert(replay_is_playing());
+  return ticks[next_tick++];
+}
+
+void replay_play_keys(key_handler_t handler, void *state) {
+  while (next_key < num_keys && keys[next_key].frame <= frame) {
+    key_record_t *record = &keys[next_key++];
+    if (handler != NULL) {
+      handler(record->key, record->type, record->held_time, state);
+    }
+  }
+}
+
+void replay_end_frame(void) { frame++; }
+
+void replay_stop(void) {
+  if (record_file == NULL) {
+    return;
+  }
+  uint8_t tag = REPLAY_END;
+  write_field(&tag, sizeof(tag));
+  write_field(&frame, sizeof(frame));
+  fclose(record_file);
+  record_file = NULL;
+}
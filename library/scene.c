@@ -0,0 +1,110 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "collision.h"
+#include "scene.h"
+
+const size_t SCENE_INITIAL_BODIES = 64;
+const size_t SCENE_INITIAL_FORCES = 16;
+
+/**
+ * A force creator with its aux value and the bodies it acts on.
+ */
+typedef struct {
+  force_creator_t forcer;
+  void *aux;
+  free_func_t aux_freer;
+  list_t *bodies;
+} force_entry_t;
+
+struct scene {
+  list_t *bodies;
+  list_t *forces;
+};
+
+static void force_entry_free(force_entry_t *entry) {
+  if (entry->aux_freer != NULL) {
+    entry->aux_freer(entry->aux);
+  }
+  list_free(entry->bodies);
+  free(entry);
+}
+
+/** Frees a body along with its cached collision shape */
+static void scene_body_free(body_t *body) {
+  collision_forget_body(body);
+  body_free(body);
+}
+
+scene_t *scene_init(void) {
+  scene_t *scene = malloc(sizeof(scene_t));
+  assert(scene != NULL);
+  scene->bodies = list_init(SCENE_INITIAL_BODIES, (free_func_t)scene_body_free);
+  scene->forces =
+      list_init(SCENE_INITIAL_FORCES, (free_func_t)force_entry_free);
+  return scene;
+}
+
+size_t scene_bodies(scene_t *scene) { return list_size(scene->bodies); }
+
+body_t *scene_get_body(scene_t *scene, size_t index) {
+  return list_get(scene->bodies, index);
+}
+
+void scene_add_body(scene_t *scene, body_t *body) {
+  list_add(scene->bodies, body);
+}
+
+void scene_add_force_creator(scene_t *scene, force_creator_t force_creator,
+                             void *aux, list_t *bodies, free_func_t freer) {
+  force_entry_t *entry = malloc(sizeof(force_entry_t));
+  assert(entry != NULL);
+  *entry = (force_entry_t){.forcer = force_creator,
+                           .aux = aux,
+                           .aux_freer = freer,
+                           .bodies = bodies};
+  list_add(scene->forces, entry);
+}
+
+/** Returns whether any of a force creator's bodies are marked for removal */
+static bool acts_on_removed(void *entry, void *aux) {
+  list_t *bodies = ((force_entry_t *)entry)->bodies;
+  size_t n = list_size(bodies);
+  for (size_t i = 0; i < n; i++) {
+    if (body_is_removed(list_get(bodies, i))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool is_removed(void *body, void *aux) { return body_is_removed(body); }
+
+void scene_remove_body(scene_t *scene, size_t index) {
+  body_remove(scene_get_body(scene, index));
+  list_remove_if(scene->forces, acts_on_removed, NULL);
+  scene_body_free(list_remove(scene->bodies, index));
+}
+
+void scene_tick(scene_t *scene, double dt) {
+  for (size_t i = 0; i < list_size(scene->forces); i++) {
+    force_entry_t *entry = list_get(scene->forces, i);
+    entry->forcer(entry->aux, entry->bodies);
+  }
+
+  // Force creators go first, since they may refer to the removed bodies.
+  // Each sweep is a single pass, however many bodies were removed.
+  list_remove_if(scene->forces, acts_on_removed, NULL);
+  list_remove_if(scene->bodies, is_removed, NULL);
+
+  size_t n = list_size(scene->bodies);
+  for (size_t i = 0; i < n; i++) {
+    body_tick(list_get(scene->bodies, i), dt);
+  }
+}
+
+void scene_free(scene_t *scene) {
+  list_free(scene->forces);
+  list_free(scene->bodies);
+  free(scene);
+}
@@ -1,6 +1,10 @@
 #include "sdl_wrapper.h"
+#include "arena.h"
+#include "collision.h"
+#include "replay.h"
+#include "sound_bank.h"
+#include "vec_batch.h"
 #include <SDL2/SDL.h>
-#include <SDL2/SDL2_gfxPrimitives.h>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
 #include <SDL2/SDL_mixer.h>
@@ -15,7 +19,11 @@ const size_t WINDOW_HEIGHT = 750;
 const SDL_Color SDL_BLACK = {0, 0, 0};
 const int8_t FONT_HEIGHT_SCALE = 2;
 const double MS_PER_S = 1000.0;
-
+/**
+ * The frame time reported by sdl_fixed_tick().
+ */
+const double FIXED_TICK_DT = 1.0 / 60.0;
+const size_t INITIAL_BATCH_CAPACITY = 256;
 /**
  * The coordinate at the center of the screen.
  */
@@ -24,6 +32,15 @@ vector_t center;
  * The coordinate difference from the center to the top right corner.
  */
 vector_t max_diff;
+/**
+ * The mapping from scene to window coordinates.
+ * Recomputed by update_view() only when the window is resized.
+ */
+view_transform_t view;
+/**
+ * The world position of the bottom left corner of the view.
+ */
+vector_t camera = {0, 0};
 /**
  * The SDL window where the scene is rendered.
  */
@@ -43,48 +60,104 @@ key_handler_t key_handler = NULL;
  */
 uint32_t key_start_timestamp;
 /**
- * The value of clock() when time_since_last_tick() was last called.
- * Initially 0.
+ * The value of SDL_GetPerformanceCounter() when sdl_monotonic_tick() was last
+ * called. Initially 0.
  */
-clock_t last_clock = 0;
-
-/** Computes the center of the window in pixel coordinates */
-vector_t get_window_center(void) {
-  int *width = malloc(sizeof(*width)), *height = malloc(sizeof(*height));
-  assert(width != NULL);
-  assert(height != NULL);
-  SDL_GetWindowSize(window, width, height);
-  vector_t dimensions = {.x = *width, .y = *height};
-  free(width);
-  free(height);
-  return vec_multiply(0.5, dimensions);
-}
+uint64_t last_counter = 0;
+/**
+ * The time source behind time_since_last_tick().
+ * A HEADLESS build steps a fixed amount per frame so runs are reproducible.
+ */
+#ifdef HEADLESS
+tick_source_t tick_source = sdl_fixed_tick;
+#else
+tick_source_t tick_source = sdl_monotonic_tick;
+#endif
+/**
+ * The render and audio counters returned by sdl_get_stats().
+ */
+sdl_stats_t stats;
+/**
+ * The value of stats when the current frame started,
+ * and the counters of the last finished frame.
+ */
+sdl_stats_t frame_start_stats;
+sdl_stats_t last_frame_stats;
+
+/**
+ * The body polygons queued by sdl_draw_body() since the last flush,
+ * fanned into triangles. The buffers are reused from frame to frame.
+ */
+SDL_Vertex *batch_vertices = NULL;
+size_t batch_vertex_count = 0;
+size_t batch_vertex_capacity = 0;
+int *batch_indices = NULL;
+size_t batch_index_count = 0;
+/**
+ * The bodies queued since the last flush. Headless builds queue no vertices
+ * but still count bodies, so their draw calls match a windowed build's.
+ */
+size_t batch_body_count = 0;
+size_t batch_index_capacity = 0;
 
 /**
- * Computes the scaling factor between scene coordinates and pixel coordinates.
+ * Recomputes the view transform from the current window size.
  * The scene is scaled by the same factor in the x and y dimensions,
- * chosen to maximize the size of the scene while keeping it in the window.
+ * chosen to maximize the size of the scene while keeping it in the window,
+ * and the center of the scene is mapped to the center of the window.
  */
-double get_scene_scale(vector_t window_center) {
-  // Scale scene so it fits entirely in the window
+static void update_view(void) {
+  int width = WINDOW_WIDTH, height = WINDOW_HEIGHT;
+#ifndef HEADLESS
+  SDL_GetWindowSize(window, &width, &height);
+#endif
+  vector_t window_center = {.x = width / 2.0, .y = height / 2.0};
   double x_scale = window_center.x / max_diff.x,
          y_scale = window_center.y / max_diff.y;
-  return x_scale < y_scale ? x_scale : y_scale;
+  view.scale = x_scale < y_scale ? x_scale : y_scale;
+  view.offset_x = window_center.x - view.scale * (center.x + camera.x);
+  // Flip y axis since positive y is down on the screen
+  view.offset_y = window_center.y + view.scale * (center.y + camera.y);
 }
 
 /** Maps a scene coordinate to a window coordinate */
-vector_t get_window_position(vector_t scene_pos, vector_t window_center) {
-  // Scale scene coordinates by the scaling factor
-  // and map the center of the scene to the center of the window
-  vector_t scene_center_offset = vec_subtract(scene_pos, center);
-  double scale = get_scene_scale(window_center);
-  vector_t pixel_center_offset = vec_multiply(scale, scene_center_offset);
-  vector_t pixel = {.x = round(window_center.x + pixel_center_offset.x),
-                    // Flip y axis since positive y is down on the screen
-                    .y = round(window_center.y - pixel_center_offset.y)};
+static vector_t get_window_position(vector_t scene_pos) {
+  vector_t pixel;
+  view_project_points(&view, &scene_pos, &pixel, 1);
   return pixel;
 }
 
+
+void view_project_points(const view_transform_t *view, const vector_t *points,
+                         vector_t *pixels, size_t n) {
+  vec_affine_t map = {.xx = view->scale,
+                      .xy = 0,
+                      .yx = 0,
+                      .yy = -view->scale,
+                      .offset = {view->offset_x, view->offset_y}};
+  vec_batch_affine(pixels, points, n, &map);
+  // A second straight-line pass, so it can be vectorized too
+  for (size_t i = 0; i < n; i++) {
+    pixels[i].x = floor(pixels[i].x + 0.5);
+    pixels[i].y = floor(pixels[i].y + 0.5);
+  }
+}
+
+view_transform_t sdl_get_view(void) { return view; }
+
+void sdl_set_camera(vector_t position) {
+  vector_t shift = vec_subtract(position, camera);
+  camera = position;
+  view.offset_x -= view.scale * shift.x;
+  view.offset_y += view.scale * shift.y;
+}
+
+bool sdl_body_visible(body_t *body) {
+  aabb_t view_box = {vec_add(camera, vec_subtract(center, max_diff)),
+                     vec_add(camera, vec_add(center, max_diff))};
+  return aabb_overlaps(collision_body_aabb(body), view_box);
+}
+
 /**
  * Converts an SDL key code to a char.
  * 7-bit ASCII characters are just returned
@@ -115,55 +188,115 @@ void sdl_init(vector_t min, vector_t max) {
 
   center = vec_multiply(0.5, vec_add(min, max));
   max_diff = vec_subtract(max, center);
+  stats = (sdl_stats_t){0};
+#ifndef HEADLESS
   SDL_Init(SDL_INIT_EVERYTHING);
   window = SDL_CreateWindow(WINDOW_TITLE, SDL_WINDOWPOS_CENTERED,
                             SDL_WINDOWPOS_CENTERED, WINDOW_WIDTH, WINDOW_HEIGHT,
                             SDL_WINDOW_RESIZABLE);
   renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_PRESENTVSYNC);
+  TTF_Init();
+  Mix_Init(0);
+  Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 1024);
+  sound_bank_init();
+#endif
+  update_view();
 }
 
 bool sdl_is_done(state_t *state) {
-  SDL_Event *event = malloc(sizeof(*event));
-  assert(event != NULL);
-  while (SDL_PollEvent(event)) {
-    switch (event->type) {
+#ifndef HEADLESS
+  SDL_Event event;
+  while (SDL_PollEvent(&event)) {
+    switch (event.type) {
     case SDL_QUIT:
-      free(event);
       return true;
+    case SDL_WINDOWEVENT:
+      if (event.window.event == SDL_WINDOWEVENT_RESIZED) {
+        update_view();
+      }
+      break;
     case SDL_KEYDOWN:
     case SDL_KEYUP:
-      // Skip the keypress if no handler is configured
+      // Skip the keypress if no handler is configured,
+      // a recording is feeding the keys instead,
       // or an unrecognized key was pressed
-      if (key_handler == NULL)
+      if (key_handler == NULL || replay_is_playing())
         break;
-      char key = get_keycode(event->key.keysym.sym);
+      char key = get_keycode(event.key.keysym.sym);
       if (key == '\0')
         break;
 
-      uint32_t timestamp = event->key.timestamp;
-      if (!event->key.repeat) {
+      uint32_t timestamp = event.key.timestamp;
+      if (!event.key.repeat) {
         key_start_timestamp = timestamp;
       }
       key_event_type_t type =
-          event->type == SDL_KEYDOWN ? KEY_PRESSED : KEY_RELEASED;
+          event.type == SDL_KEYDOWN ? KEY_PRESSED : KEY_RELEASED;
       double held_time = (timestamp - key_start_timestamp) / MS_PER_S;
+      replay_record_key(key, type, held_time);
       key_handler(key, type, held_time, state);
       break;
     }
   }
-  free(event);
+#endif
+  replay_play_keys(key_handler, state);
+  replay_end_frame();
   return false;
 }
 
 void sdl_clear(void) {
+#ifndef HEADLESS
   SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
   SDL_RenderClear(renderer);
+#endif
+}
+
+/** Grows the batch buffers to fit extra vertices and indices */
+static void batch_reserve(size_t extra_vertices, size_t extra_indices) {
+  if (batch_vertex_count + extra_vertices > batch_vertex_capacity) {
+    size_t capacity = batch_vertex_capacity ? batch_vertex_capacity
+                                            : INITIAL_BATCH_CAPACITY;
+    while (batch_vertex_count + extra_vertices > capacity) {
+      capacity *= 2;
+    }
+    batch_vertices = realloc(batch_vertices, sizeof(SDL_Vertex) * capacity);
+    assert(batch_vertices != NULL);
+    batch_vertex_capacity = capacity;
+  }
+  if (batch_index_count + extra_indices > batch_index_capacity) {
+    size_t capacity = batch_index_capacity ? batch_index_capacity
+                                           : INITIAL_BATCH_CAPACITY;
+    while (batch_index_count + extra_indices > capacity) {
+      capacity *= 2;
+    }
+    batch_indices = realloc(batch_indices, sizeof(int) * capacity);
+    assert(batch_indices != NULL);
+    batch_index_capacity = capacity;
+  }
+}
+
+/** Submits every queued body polygon in a single geometry call */
+static void batch_flush(void) {
+  if (batch_body_count == 0) {
+    return;
+  }
+  stats.draw_calls++;
+  batch_body_count = 0;
+#ifndef HEADLESS
+  SDL_RenderGeometry(renderer, NULL, batch_vertices, batch_vertex_count,
+                     batch_indices, batch_index_count);
+#endif
+  batch_vertex_count = 0;
+  batch_index_count = 0;
 }
 
 void sdl_draw_body(body_t *body) {
+  stats.bodies_drawn++;
+  batch_body_count++;
+#ifndef HEADLESS
   // Check parameters
-  list_t *points = body_get_shape(body);
-  size_t n = list_size(points);
+  size_t n;
+  vector_t *pixels = collision_copy_vertices(body, frame_arena(), &n);
   assert(n >= 3);
   color_t color = body_get_color(body);
   double r = color.red;
@@ -174,31 +307,36 @@ void sdl_draw_body(body_t *body) {
   assert(0 <= g && g <= 1);
   assert(0 <= b && b <= 1);
 
-  vector_t window_center = get_window_center();
+  SDL_Color vertex_color = {r * 255, g * 255, b * 255, 255};
 
   // Convert each vertex to a point on screen
-  int16_t *x_points = malloc(sizeof(*x_points) * n),
-          *y_points = malloc(sizeof(*y_points) * n);
-  assert(x_points != NULL);
-  assert(y_points != NULL);
+  view_project_points(&view, pixels, pixels, n);
+
+  batch_reserve(n, 3 * (n - 2));
+  int first = batch_vertex_count;
   for (size_t i = 0; i < n; i++) {
-    vector_t *vertex = list_get(points, i);
-    vector_t pixel = get_window_position(*vertex, window_center);
-    x_points[i] = pixel.x;
-    y_points[i] = pixel.y;
+    batch_vertices[batch_vertex_count++] =
+        (SDL_Vertex){.position = {pixels[i].x, pixels[i].y},
+                     .color = vertex_color,
+                     .tex_coord = {0, 0}};
   }
 
-  // Draw body with the given color
-  filledPolygonRGBA(renderer, x_points, y_points, n, r * 255, g * 255, b * 255,
-                    255);
-  sdl_show();
-  free(x_points);
-  free(y_points);
+  // Bodies are convex, so a fan from the first vertex covers the polygon
+  for (size_t i = 1; i + 1 < n; i++) {
+    batch_indices[batch_index_count++] = first;
+    batch_indices[batch_index_count++] = first + i;
+    batch_indices[batch_index_count++] = first + i + 1;
+  }
+#endif
 }
 
 SDL_Texture *sdl_get_image_texture(const char *image_path) {
+#ifndef HEADLESS
   SDL_Texture *img = IMG_LoadTexture(renderer, image_path);
   return img;
+#else
+  return NULL;
+#endif
 }
 
 SDL_Rect *sdl_get_rect(double x, double y, double w, double h) {
@@ -210,27 +348,49 @@ SDL_Rect *sdl_get_rect(double x, double y, double w, double h) {
   return rect;
 }
 
+SDL_Rect *sdl_get_frame_rect(double x, double y, double w, double h) {
+  SDL_Rect *rect = arena_alloc(frame_arena(), sizeof(SDL_Rect));
+  *rect = (SDL_Rect){.x = x, .y = y, .w = w, .h = h};
+  return rect;
+}
+
 void sdl_render_image(SDL_Texture *image_texture, SDL_Rect *rect) {
+  stats.images_rendered++;
+  stats.draw_calls++;
+#ifndef HEADLESS
   SDL_RenderCopy(renderer, image_texture, NULL, rect);
+#endif
 }
 
 void sdl_show(void) {
-  // Draw boundary lines
-  vector_t window_center = get_window_center();
-  vector_t max = vec_add(center, max_diff),
-           min = vec_subtract(center, max_diff);
-  vector_t max_pixel = get_window_position(max, window_center),
-           min_pixel = get_window_position(min, window_center);
-  SDL_Rect *boundary = malloc(sizeof(*boundary));
-  boundary->x = min_pixel.x;
-  boundary->y = max_pixel.y;
-  boundary->w = max_pixel.x - min_pixel.x;
-  boundary->h = min_pixel.y - max_pixel.y;
+  batch_flush();
+  // The boundary lines drawn below
+  stats.draw_calls++;
+  stats.presents++;
+  last_frame_stats = (sdl_stats_t){
+      .presents = stats.presents - frame_start_stats.presents,
+      .draw_calls = stats.draw_calls - frame_start_stats.draw_calls,
+      .bodies_drawn = stats.bodies_drawn - frame_start_stats.bodies_drawn,
+      .images_rendered =
+          stats.images_rendered - frame_start_stats.images_rendered,
+      .texts_rendered = stats.texts_rendered - frame_start_stats.texts_rendered,
+      .sounds_played = stats.sounds_played - frame_start_stats.sounds_played};
+  frame_start_stats = stats;
+#ifndef HEADLESS
+  // Draw boundary lines around the view, wherever the camera is
+  vector_t max = vec_add(camera, vec_add(center, max_diff)),
+           min = vec_add(camera, vec_subtract(center, max_diff));
+  vector_t max_pixel = get_window_position(max),
+           min_pixel = get_window_position(min);
+  SDL_Rect boundary = {.x = min_pixel.x,
+                       .y = max_pixel.y,
+                       .w = max_pixel.x - min_pixel.x,
+                       .h = min_pixel.y - max_pixel.y};
   SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-  SDL_RenderDrawRect(renderer, boundary);
-  free(boundary);
+  SDL_RenderDrawRect(renderer, &boundary);
 
   SDL_RenderPresent(renderer);
+#endif
 }
 
 void sdl_render_scene(scene_t *scene) {
@@ -238,61 +398,105 @@ void sdl_render_scene(scene_t *scene) {
   size_t body_count = scene_bodies(scene);
   for (size_t i = 0; i < body_count; i++) {
     body_t *body = scene_get_body(scene, i);
-    sdl_draw_body(body);
+    // Removed bodies stay in the scene until the next scene_tick()
+    if (!body_is_removed(body) && sdl_body_visible(body)) {
+      sdl_draw_body(body);
+    }
   }
-  sdl_show();
+  batch_flush();
 }
 
 void sdl_on_key(key_handler_t handler) { key_handler = handler; }
 
 double time_since_last_tick(void) {
-  clock_t now = clock();
-  double difference = last_clock
-                          ? (double)(now - last_clock) / CLOCKS_PER_SEC
-                          : 0.0; // return 0 the first time this is called
-  last_clock = now;
+  double dt = replay_is_playing() ? replay_next_tick() : tick_source();
+  replay_record_tick(dt);
+  return dt;
+}
+
+void sdl_set_tick_source(tick_source_t source) {
+  assert(source != NULL);
+  tick_source = source;
+}
+
+double sdl_monotonic_tick(void) {
+  uint64_t now = SDL_GetPerformanceCounter();
+  double difference =
+      last_counter ? (double)(now - last_counter) / SDL_GetPerformanceFrequency()
+                   : 0.0; // return 0 the first time this is called
+  last_counter = now;
   return difference;
 }
 
+double sdl_fixed_tick(void) { return FIXED_TICK_DT; }
+
 void sdl_render_text(SDL_Surface *surfacemssage, SDL_Rect *rect) {
+  stats.texts_rendered++;
+  stats.draw_calls++;
+#ifndef HEADLESS
   SDL_Texture *text = SDL_CreateTextureFromSurface(renderer, surfacemssage);
   SDL_RenderCopy(renderer, text, NULL, rect);
   SDL_DestroyTexture(text);
+#endif
 }
 
-SDL_Rect sdl_get_body_bounding_box(body_t *body) {
-  double min_x = __DBL_MAX__;
-  double min_y = __DBL_MAX__;
-  double max_x = -__DBL_MAX__;
-  double max_y = -__DBL_MAX__;
-
-
-
-  list_t *points = body_get_shape(body);
-  vector_t point;
-
-  vector_t window_center = get_window_center();
-
-  for (size_t i = 0; i < list_size(points); i++) {
-    point = *(vector_t *)list_get(points, i);
-    point = get_window_position(point, window_center);
+TTF_Font *sdl_get_font(const char *font_path, size_t font_size) {
+#ifndef HEADLESS
+  return TTF_OpenFont(font_path, font_size);
+#else
+  return NULL;
+#endif
+}
 
-    min_x = fmin(min_x, point.x);
-    max_y = fmax(max_y, point.y);
-    max_x = fmax(max_x, point.x);
-    min_y = fmin(min_y, point.y);
+SDL_Texture *sdl_get_text_texture(TTF_Font *font, const char *text) {
+#ifndef HEADLESS
+  SDL_Surface *message = TTF_RenderText_Solid(font, text, SDL_BLACK);
+  if (message == NULL) {
+    return NULL;
   }
+  SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, message);
+  SDL_FreeSurface(message);
+  return texture;
+#else
+  return NULL;
+#endif
+}
+
+void sdl_render_text_region(SDL_Texture *texture, SDL_Rect *src,
+                            SDL_Rect *dst) {
+  stats.texts_rendered++;
+  stats.draw_calls++;
+#ifndef HEADLESS
+  SDL_RenderCopy(renderer, texture, src, dst);
+#endif
+}
 
-  SDL_Rect rect = {min_x, min_y, max_x - min_x,
-                   max_y - min_y};
-  list_free(points);
+SDL_Rect sdl_get_body_bounding_box(body_t *body) {
+  // Projection is monotonic, so the box's corners land on the pixel box.
+  // Window y grows downwards, so the top left corner is (min x, max y).
+  aabb_t box = collision_body_aabb(body);
+  vector_t corners[2] = {{box.min.x, box.max.y}, {box.max.x, box.min.y}};
+  view_project_points(&view, corners, corners, 2);
+
+  SDL_Rect rect = {corners[0].x, corners[0].y, corners[1].x - corners[0].x,
+                   corners[1].y - corners[0].y};
   return rect;
 }
 
 void SDL_play_music(const char *path){
+  stats.sounds_played++;
+#ifndef HEADLESS
   Mix_PlayMusic(Mix_LoadMUS(path), -1);
+#endif
 }
 
 void SDL_play_sound(const char *path){
-  Mix_PlayChannel(-1, Mix_LoadWAV(path), 0);
+  stats.sounds_played++;
+#ifndef HEADLESS
+  sound_bank_play(sound_bank_get(path));
+#endif
 }
+
+sdl_stats_t sdl_get_stats(void) { return stats; }
+
+sdl_stats_t sdl_get_frame_stats(void) { return last_frame_stats; }
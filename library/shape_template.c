@@ -0,0 +1,147 @@
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "shape_template.h"
+#include "vec_array.h"
+
+enum { SHAPE_TEMPLATE_CAPACITY = 16 };
+
+typedef enum {
+  SHAPE_ELLIPSE,
+  SHAPE_RECT,
+} shape_type_t;
+
+struct shape_template {
+  shape_type_t type;
+  /** The radii of an ellipse, or the width and height of a rectangle */
+  double a;
+  double b;
+  size_t num_vertices;
+  /** The vertices around the centroid */
+  vec_array_t *vertices;
+};
+
+/**
+ * Every template made so far. There are only a handful of distinct shapes,
+ * so lookups are a linear scan.
+ */
+static shape_template_t templates[SHAPE_TEMPLATE_CAPACITY];
+static size_t num_templates = 0;
+
+/**
+ * The vertices of one body, in a single allocation.
+ * The shape list points at the vertex inside each slot, and the slot's back
+ * pointer lets the list's freer find the block.
+ */
+typedef struct vertex_block vertex_block_t;
+
+typedef struct {
+  vertex_block_t *block;
+  vector_t vertex;
+} vertex_slot_t;
+
+struct vertex_block {
+  size_t live;
+  vertex_slot_t slots[];
+};
+
+static shape_template_t *find_template(shape_type_t type, double a, double b,
+                                       size_t num_vertices) {
+  for (size_t i = 0; i < num_templates; i++) {
+    shape_template_t *template = &templates[i];
+    if (template->type == type && template->a == a && template->b == b &&
+        template->num_vertices == num_vertices) {
+      return template;
+    }
+  }
+  return NULL;
+}
+
+static shape_template_t *add_template(shape_type_t type, double a, double b,
+                                      size_t num_vertices) {
+  assert(num_templates < SHAPE_TEMPLATE_CAPACITY);
+  shape_template_t *template = &templates[num_templates++];
+  template->type = type;
+  template->a = a;
+  template->b = b;
+  template->num_vertices = num_vertices;
+  template->vertices = vec_array_init(num_vertices);
+  return template;
+}
+
+const shape_template_t *shape_template_ellipse(double x_radius, double y_radius,
+                                               size_t num_points) {
+  shape_template_t *template =
+      find_template(SHAPE_ELLIPSE, x_radius, y_radius, num_points);
+  if (template != NULL) {
+    return template;
+  }
+  template = add_template(SHAPE_ELLIPSE, x_radius, y_radius, num_points);
+  for (size_t i = 0; i < num_points; i++) {
+    double angle = 2 * M_PI * i / num_points;
+    vec_array_add(template->vertices,
+                  (vector_t){x_radius * cos(angle), y_radius * sin(angle)});
+  }
+  return template;
+}
+
+const shape_template_t *shape_template_circle(double radius,
+                                              size_t num_points) {
+  return shape_template_ellipse(radius, radius, num_points);
+}
+
+const shape_template_t *shape_template_rect(double width, double height) {
+  shape_template_t *template = find_template(SHAPE_RECT, width, height, 4);
+  if (template != NULL) {
+    return template;
+  }
+  template = add_template(SHAPE_RECT, width, height, 4);
+  double half_w = width / 2;
+  double half_h = height / 2;
+  vector_t corners[] = {
+      {-half_w, -half_h}, {half_w, -half_h}, {half_w, half_h}, {-half_w, half_h}};
+  vec_array_append(template->vertices, corners, 4);
+  return template;
+}
+
+size_t shape_template_size(const shape_template_t *template) {
+  return template->num_vertices;
+}
+
+vector_t shape_template_vertex(const shape_template_t *template, size_t i) {
+  return vec_array_get(template->vertices, i);
+}
+
+/** Frees a vertex's block once every vertex in it has been freed */
+static void vertex_free(void *vertex) {
+  vertex_slot_t *slot =
+      (vertex_slot_t *)((char *)vertex - offsetof(vertex_slot_t, vertex));
+  vertex_block_t *block = slot->block;
+  assert(block->live > 0);
+  block->live--;
+  if (block->live == 0) {
+    free(block);
+  }
+}
+
+list_t *shape_template_instantiate(const shape_template_t *template,
+                                   vector_t center) {
+  size_t n = template->num_vertices;
+  vertex_block_t *block =
+      malloc(sizeof(vertex_block_t) + sizeof(vertex_slot_t) * n);
+  assert(block != NULL);
+  block->live = n;
+
+  const vector_t *vertices = vec_array_data(template->vertices);
+  list_t *shape = list_init(n, vertex_free);
+  for (size_t i = 0; i < n; i++) {
+    vertex_slot_t *slot = &block->slots[i];
+    slot->block = block;
+    slot->vertex = vec_add(center, vertices[i]);
+    list_add(shape, &slot->vertex);
+  }
+  return shape;
+}
@@ -0,0 +1,80 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "replay.h"
+#include "sim.h"
+
+const size_t SIM_DEFAULT_STEPS = 10000;
+
+static bool seed_set = false;
+static unsigned int seed_value = 0;
+
+static void sim_usage(const char *program) {
+  fprintf(stderr,
+          "usage: %s [--steps N] [--seed S] [--record FILE] [--replay FILE] "
+          "[--trace FILE]\n",
+          program);
+  exit(1);
+}
+
+sim_options_t sim_parse_args(int argc, char *argv[]) {
+  sim_options_t opts = {.steps = SIM_DEFAULT_STEPS,
+                        .seed = 0,
+                        .record_path = NULL,
+                        .replay_path = NULL,
+                        .trace_path = NULL};
+  bool has_steps = false;
+  bool has_seed = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (i + 1 >= argc) {
+      sim_usage(argv[0]);
+    }
+    if (strcmp(argv[i], "--steps") == 0) {
+      opts.steps = strtoul(argv[++i], NULL, 10);
+      has_steps = true;
+    } else if (strcmp(argv[i], "--seed") == 0) {
+      opts.seed = strtoul(argv[++i], NULL, 10);
+      has_seed = true;
+    } else if (strcmp(argv[i], "--record") == 0) {
+      opts.record_path = argv[++i];
+    } else if (strcmp(argv[i], "--replay") == 0) {
+      opts.replay_path = argv[++i];
+    } else if (strcmp(argv[i], "--trace") == 0) {
+      opts.trace_path = argv[++i];
+    } else {
+      sim_usage(argv[0]);
+    }
+  }
+
+  if (opts.replay_path != NULL) {
+    opts.seed = replay_load(opts.replay_path);
+    if (!has_steps) {
+      opts.steps = replay_frames();
+    }
+    sim_set_seed(opts.seed);
+  } else if (has_seed) {
+    sim_set_seed(opts.seed);
+  } else {
+    opts.seed = sim_get_seed();
+  }
+
+  if (opts.record_path != NULL) {
+    replay_start_recording(opts.record_path, opts.seed);
+  }
+  return opts;
+}
+
+void sim_set_seed(unsigned int seed) {
+  seed_value = seed;
+  seed_set = true;
+}
+
+unsigned int sim_get_seed(void) {
+  if (!seed_set) {
+    sim_set_seed(time(NULL));
+  }
+  return seed_value;
+}
@@ -0,0 +1,78 @@
+#include <SDL2/SDL_mixer.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "constants.h"
+#include "list.h"
+#include "sound_bank.h"
+
+const size_t SOUND_BANK_INIT_CAPACITY = 8;
+
+typedef struct {
+  const char *path;
+  Mix_Chunk *chunk;
+} sound_entry_t;
+
+static list_t *SOUND_BANK = NULL;
+static sound_bank_stats_t stats;
+
+static void sound_entry_free(sound_entry_t *entry) {
+  if (entry->chunk != NULL) {
+    Mix_FreeChunk(entry->chunk);
+  }
+  free(entry);
+}
+
+void sound_bank_init(void) {
+  if (SOUND_BANK == NULL) {
+    SOUND_BANK =
+        list_init(SOUND_BANK_INIT_CAPACITY, (free_func_t)sound_entry_free);
+  }
+  stats = (sound_bank_stats_t){0};
+  for (size_t i = 0; i < NUM_SOUND_PATHS; i++) {
+    sound_bank_get(*SOUND_PATHS[i]);
+  }
+}
+
+sound_t sound_bank_get(const char *path) {
+  assert(SOUND_BANK != NULL);
+  size_t n = list_size(SOUND_BANK);
+  for (size_t i = 0; i < n; i++) {
+    sound_entry_t *entry = list_get(SOUND_BANK, i);
+    if (entry->path == path) {
+      return i;
+    }
+  }
+  for (size_t i = 0; i < n; i++) {
+    sound_entry_t *entry = list_get(SOUND_BANK, i);
+    if (strcmp(entry->path, path) == 0) {
+      return i;
+    }
+  }
+
+  sound_entry_t *entry = malloc(sizeof(sound_entry_t));
+  assert(entry != NULL);
+  entry->path = path;
+  entry->chunk = Mix_LoadWAV(path);
+  stats.loads++;
+  list_add(SOUND_BANK, entry);
+  return n;
+}
+
+void sound_bank_play(sound_t sound) {
+  sound_entry_t *entry = list_get(SOUND_BANK, sound);
+  stats.plays++;
+  if (entry->chunk != NULL) {
+    Mix_PlayChannel(-1, entry->chunk, 0);
+  }
+}
+
+sound_bank_stats_t sound_bank_get_stats(void) { return stats; }
+
+void sound_bank_free(void) {
+  if (SOUND_BANK != NULL) {
+    list_free(SOUND_BANK);
+    SOUND_BANK = NULL;
+  }
+}
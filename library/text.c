@@ -0,0 +1,124 @@
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "asset_cache.h"
+#include "sdl_wrapper.h"
+#include "text.h"
+
+enum { MAX_TEXT_LENGTH = 64, NUM_ASCII = 128 };
+
+struct text_label {
+  TTF_Font *font;
+  SDL_Texture *texture;
+  /** The string the texture holds */
+  char text[MAX_TEXT_LENGTH];
+};
+
+struct glyph_atlas {
+  SDL_Texture *texture;
+  /** Source rectangle of each character in the texture; w is 0 if absent */
+  SDL_Rect glyphs[NUM_ASCII];
+};
+
+text_label_t *text_label_init(const char *font_path, size_t font_size) {
+  text_label_t *label = malloc(sizeof(text_label_t));
+  assert(label != NULL);
+  label->font = asset_cache_font_get_or_create(font_path, font_size);
+  label->texture = NULL;
+  label->text[0] = '\0';
+  return label;
+}
+
+void text_label_draw(text_label_t *label, const char *text, SDL_Rect *rect) {
+  assert(strlen(text) < MAX_TEXT_LENGTH);
+  if (label->texture == NULL || strcmp(label->text, text) != 0) {
+    if (label->texture != NULL) {
+      SDL_DestroyTexture(label->texture);
+    }
+    label->texture = sdl_get_text_texture(label->font, text);
+    strcpy(label->text, text);
+  }
+  sdl_render_text_region(label->texture, NULL, rect);
+}
+
+void text_label_free(text_label_t *label) {
+  if (label->texture != NULL) {
+    SDL_DestroyTexture(label->texture);
+  }
+  free(label);
+}
+
+glyph_atlas_t *glyph_atlas_init(const char *font_path, size_t font_size,
+                                const char *glyphs) {
+  size_t n = strlen(glyphs);
+  assert(n < MAX_TEXT_LENGTH);
+  glyph_atlas_t *atlas = malloc(sizeof(glyph_atlas_t));
+  assert(atlas != NULL);
+  memset(atlas->glyphs, 0, sizeof(atlas->glyphs));
+
+  TTF_Font *font = asset_cache_font_get_or_create(font_path, font_size);
+  atlas->texture = sdl_get_text_texture(font, glyphs);
+  if (font == NULL) {
+    // No font in a HEADLESS build. One-pixel placeholder glyphs keep
+    // glyph_atlas_draw() making the same calls as a windowed build.
+    for (size_t i = 0; i < n; i++) {
+      unsigned char c = glyphs[i];
+      assert(c < NUM_ASCII);
+      atlas->glyphs[c] = (SDL_Rect){i, 0, 1, 1};
+    }
+    return atlas;
+  }
+
+  // Each character spans from the width of the characters before it
+  // to the width including it, which accounts for kerning
+  char prefix[MAX_TEXT_LENGTH];
+  int left = 0, height = 0;
+  for (size_t i = 0; i < n; i++) {
+    int right;
+    memcpy(prefix, glyphs, i + 1);
+    prefix[i + 1] = '\0';
+    TTF_SizeText(font, prefix, &right, &height);
+
+    unsigned char c = glyphs[i];
+    assert(c < NUM_ASCII);
+    if (atlas->glyphs[c].w == 0) {
+      atlas->glyphs[c] = (SDL_Rect){left, 0, right - left, height};
+    }
+    left = right;
+  }
+  return atlas;
+}
+
+void glyph_atlas_draw(glyph_atlas_t *atlas, const char *text, SDL_Rect *rect) {
+  int total_width = 0;
+  for (const char *c = text; *c != '\0'; c++) {
+    total_width += atlas->glyphs[(unsigned char)*c % NUM_ASCII].w;
+  }
+  if (total_width == 0) {
+    return;
+  }
+
+  // Stretch the row of glyphs over rect, as if it were rendered in one piece
+  double scale = (double)rect->w / total_width;
+  double x = rect->x;
+  for (const char *c = text; *c != '\0'; c++) {
+    SDL_Rect *glyph = &atlas->glyphs[(unsigned char)*c % NUM_ASCII];
+    if (glyph->w == 0) {
+      continue;
+    }
+    double next_x = x + glyph->w * scale;
+    SDL_Rect quad = {(int)x, rect->y, (int)next_x - (int)x, rect->h};
+    sdl_render_text_region(atlas->texture, glyph, &quad);
+    x = next_x;
+  }
+}
+
+void glyph_atlas_free(glyph_atlas_t *atlas) {
+  if (atlas->texture != NULL) {
+    SDL_DestroyTexture(atlas->texture);
+  }
+  free(atlas);
+}
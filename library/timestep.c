@@ -0,0 +1,26 @@
+#include <assert.h>
+
+#include "timestep.h"
+
+timestep_t timestep_init(double step, size_t max_substeps) {
+  assert(step > 0);
+  assert(max_substeps > 0);
+  return (timestep_t){
+      .step = step, .max_substeps = max_substeps, .accumulator = 0};
+}
+
+size_t timestep_advance(timestep_t *timestep, double dt) {
+  timestep->accumulator += dt;
+  size_t steps = 0;
+  while (timestep->accumulator >= timestep->step &&
+         steps < timestep->max_substeps) {
+    timestep->accumulator -= timestep->step;
+    steps++;
+  }
+  if (timestep->accumulator >= timestep->step) {
+    timestep->accumulator = 0;
+  }
+  return steps;
+}
+
+void timestep_reset(timestep_t *timestep) { timestep->accumulator = 0; }
@@ -0,0 +1,97 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vec_array.h"
+
+const size_t VEC_ARRAY_MIN_CAPACITY = 4;
+
+struct vec_array {
+  vector_t *data;
+  size_t size;
+  size_t capacity;
+};
+
+vec_array_t *vec_array_init(size_t initial_capacity) {
+  vec_array_t *array = malloc(sizeof(vec_array_t));
+  assert(array != NULL);
+  array->capacity = initial_capacity > VEC_ARRAY_MIN_CAPACITY
+                        ? initial_capacity
+                        : VEC_ARRAY_MIN_CAPACITY;
+  array->data = malloc(sizeof(vector_t) * array->capacity);
+  assert(array->data != NULL);
+  array->size = 0;
+  return array;
+}
+
+void vec_array_free(vec_array_t *array) {
+  free(array->data);
+  free(array);
+}
+
+size_t vec_array_size(const vec_array_t *array) { return array->size; }
+
+vector_t *vec_array_data(vec_array_t *array) { return array->data; }
+
+vector_t vec_array_get(const vec_array_t *array, size_t index) {
+  assert(index < array->size);
+  return array->data[index];
+}
+
+void vec_array_set(vec_array_t *array, size_t index, vector_t value) {
+  assert(index < array->size);
+  array->data[index] = value;
+}
+
+void vec_array_reserve(vec_array_t *array, size_t capacity) {
+  if (capacity <= array->capacity) {
+    return;
+  }
+  array->data = realloc(array->data, sizeof(vector_t) * capacity);
+  assert(array->data != NULL);
+  array->capacity = capacity;
+}
+
+/** Grows the array geometrically until it has room for extra more vectors */
+static void make_room(vec_array_t *array, size_t extra) {
+  size_t needed = array->size + extra;
+  if (needed <= array->capacity) {
+    return;
+  }
+  size_t capacity = array->capacity * 2;
+  if (capacity < needed) {
+    capacity = needed;
+  }
+  vec_array_reserve(array, capacity);
+}
+
+void vec_array_add(vec_array_t *array, vector_t value) {
+  make_room(array, 1);
+  array->data[array->size++] = value;
+}
+
+void vec_array_append(vec_array_t *array, const vector_t *values, size_t n) {
+  if (n == 0) {
+    return;
+  }
+  make_room(array, n);
+  memcpy(array->data + array->size, values, sizeof(vector_t) * n);
+  array->size += n;
+}
+
+void vec_array_append_list(vec_array_t *array, list_t *list) {
+  size_t n = list_size(list);
+  make_room(array, n);
+  for (size_t i = 0; i < n; i++) {
+    array->data[array->size++] = *(vector_t *)list_get(list, i);
+  }
+}
+
+void vec_array_clear(vec_array_t *array) { array->size = 0; }
+
+vector_t vec_array_swap_remove(vec_array_t *array, size_t index) {
+  assert(index < array->size);
+  vector_t value = array->data[index];
+  array->data[index] = array->data[--array->size];
+  return value;
+}
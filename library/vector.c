@@ -0,0 +1,4 @@
+#include "vector.h"
+
+// The vector operations themselves are static inline in vector.h
+const vector_t VEC_ZERO = {.x = 0.0, .y = 0.0};
@@ -12,11 +12,12 @@
 #include "sdl_wrapper.h"
 #include "constants.h"
 #include "scene.h"
+#include "shape_template.h"
 #include"state.h"
 #include "villain.h"
 
 /**
- * Creates the body for the villain inside of the scene with VILLAIN_INFO
+ * Creates the body for the villain inside of the scene with kind ENTITY_VILLAIN
  * 
  * @param radius the radius of the body of the villain
  * @param center the center of the body of the villain inside of the scene
@@ -24,18 +25,11 @@
  */
 body_t *make_villain(double radius, vector_t center){
 
-  list_t *villain_shape  = list_init(VILLAIN_NUM_POINTS, free);
+  list_t *villain_shape = shape_template_instantiate(
+      shape_template_circle(radius, VILLAIN_NUM_POINTS), center);
 
-  for (size_t i = 0; i < VILLAIN_NUM_POINTS; i++){
-    double angle = 2 * M_PI * i / VILLAIN_NUM_POINTS;
-    vector_t *v = malloc(sizeof(vector_t));
-    *v = (vector_t){center.x + radius * cos(angle),
-                    center.y + radius * sin(angle)};
-    list_add(villain_shape, v);
-  }
-  
   body_t *villain_body = body_init_with_info(villain_shape, 1, VILLAIN_COLOR, 
-                        (void *)VILLAIN_INFO, NULL);
+                        entity_info(ENTITY_VILLAIN), NULL);
   return villain_body;
 }
 
@@ -44,13 +38,15 @@ body_t *make_villain(double radius, vector_t center){
  * with the asset of the villain image HAS TO BE CHANGED 
  * 
  * @param state the state of where we want to initalize the villain body.
- * @param villain a double pointer to the newley created villain body.
+ * @param villain set to a handle to the newley created villain body.
+ * @param camera_y the world height of the bottom of the view
  */
-void villain_init(scene_t *scene, body_t **villain){
-    *villain = make_villain(VILLAIN_RADIUS, VILLAIN_START_POS);
-    body_set_velocity(*villain, HOVER_RIGHT);
-    scene_add_body(scene, *villain);
-    asset_make_image_with_body(VILLAIN_PATH, *villain);
+void villain_init(scene_t *scene, entity_handle_t *villain, double camera_y){
+    vector_t start = {VILLAIN_START_POS.x, VILLAIN_START_POS.y + camera_y};
+    body_t *villain_body = make_villain(VILLAIN_RADIUS, start);
+    body_set_velocity(villain_body, HOVER_RIGHT);
+    *villain = entity_add(scene, villain_body);
+    asset_make_image_with_body(VILLAIN_PATH, villain_body);
     SDL_play_sound(VILLAIN_SPAWN_SOUND_PATH);
 }
 
@@ -82,25 +78,79 @@ void villain_hover(body_t **villain){
  * @return a pointer to the newly allocated bullet body
  */
 body_t *make_bullet(double radius, vector_t center){
-  list_t *bullet_shape  = list_init(BULLET_NUM_POINTS, free);
-
-    for (size_t i = 0; i < BULLET_NUM_POINTS; i++){
-      double angle = 2 * M_PI * i / BULLET_NUM_POINTS;
-      vector_t *v = malloc(sizeof(vector_t));
-      *v = (vector_t){center.x + radius * cos(angle),
-                      center.y + radius * sin(angle)};
-      list_add(bullet_shape, v);
-    }
-    
+    list_t *bullet_shape = shape_template_instantiate(
+        shape_template_circle(radius, (size_t)BULLET_NUM_POINTS), center);
+
     body_t *bullet_body = body_init_with_info(bullet_shape, 1, BULLET_COLOR, 
-                          (void *)BULLET_INFO, NULL);
+                          entity_info(ENTITY_BULLET), NULL);
     return bullet_body;
 }
 
 /**
- * Creates an asset to place on the bullet body and shoots
- * the bullet by creating a downward velocity relative to the 
- * score of the game.
+ * Where parked bullets wait, far below anything the camera can see.
+ */
+static const vector_t BULLET_PARKED_POSITION = {0, -1e9};
+
+static body_t **free_bullets = NULL;
+static size_t num_free_bullets = 0;
+static bullet_pool_stats_t bullet_stats;
+
+void bullet_pool_init(scene_t *scene){
+    free_bullets = malloc(sizeof(body_t *) * BULLET_POOL_CAPACITY);
+    assert(free_bullets != NULL);
+    num_free_bullets = 0;
+    bullet_stats = (bullet_pool_stats_t){0};
+
+    for (size_t i = 0; i < BULLET_POOL_CAPACITY; i++){
+        body_t *bullet = make_bullet(BULLET_RADIUS, BULLET_PARKED_POSITION);
+        entity_add(scene, bullet);
+        asset_make_image_with_body(BULLET_PATH, bullet);
+        // Parked bullets stay in the scene but out of the bullet list
+        entity_untrack(bullet);
+        free_bullets[num_free_bullets++] = bullet;
+    }
+}
+
+void bullet_pool_free(void){
+    free(free_bullets);
+    free_bullets = NULL;
+    num_free_bullets = 0;
+}
+
+body_t *bullet_pool_acquire(vector_t center){
+    if (num_free_bullets == 0){
+        bullet_stats.dropped++;
+        return NULL;
+    }
+    body_t *bullet = free_bullets[--num_free_bullets];
+    body_set_centroid(bullet, center);
+    entity_track(bullet);
+    bullet_stats.spawned++;
+    bullet_stats.live++;
+    return bullet;
+}
+
+void bullet_pool_release(body_t *bullet){
+    assert(num_free_bullets < BULLET_POOL_CAPACITY);
+    entity_untrack(bullet);
+    body_set_velocity(bullet, VEC_ZERO);
+    body_set_centroid(bullet, BULLET_PARKED_POSITION);
+    free_bullets[num_free_bullets++] = bullet;
+    bullet_stats.live--;
+}
+
+void bullet_pool_release_all(void){
+    while (entity_count(ENTITY_BULLET) > 0){
+        bullet_pool_release(entity_get(ENTITY_BULLET, entity_count(ENTITY_BULLET) - 1));
+    }
+}
+
+bullet_pool_stats_t bullet_pool_get_stats(void){ return bullet_stats; }
+
+/**
+ * Takes a bullet from the pool and shoots it
+ * by creating a downward velocity relative to the
+ * score of the game. Does nothing if the pool is empty.
  * 
  * @param scene the scene of the game the bullet is in 
  * @param villain the villain of the game
@@ -110,7 +160,10 @@ body_t *make_bullet(double radius, vector_t center){
 void villain_shoot_bullet(scene_t *scene, body_t *villain, uint16_t score){
     vector_t villain_center = body_get_centroid(villain);
     vector_t bullet_pos = {villain_center.x, villain_center.y - VILLAIN_RADIUS - BULLET_RADIUS};
-    body_t *bullet = make_bullet(BULLET_RADIUS, bullet_pos);
+    body_t *bullet = bullet_pool_acquire(bullet_pos);
+    if (bullet == NULL){
+        return;
+    }
 
     double multiplier = 1.0;
 
@@ -132,29 +185,23 @@ void villain_shoot_bullet(scene_t *scene, body_t *villain, uint16_t score){
 
     vector_t final_velocity = vec_multiply(multiplier, BULLET_VELOCITY);
     body_set_velocity(bullet, final_velocity);
-    scene_add_body(scene, bullet);
-    asset_make_image_with_body(BULLET_PATH, bullet);
     SDL_play_sound(BULLET_SOUND_PATH);
 }
 
 /**
- * Scans the scene for any bullet bodies that have gone
- * outside of the bounds of the screen and remvoes them
- * from the scene
+ * Scans the live bullets for any that have gone
+ * outside of the bounds of the screen and returns them
+ * to the pool
  * 
  * @param scene the scene of the game
+ * @param camera_y the world height of the bottom of the view
  */
-void remove_offscreen_bullets(scene_t *scene){
-    for (ssize_t i = scene_bodies(scene) - 1; i >= 0; i--) {
-        body_t *body = scene_get_body(scene, i);
-        void *info = body_get_info(body);
-
-        if (info != NULL && strcmp((char *)info, BULLET_INFO) == 0) {
-            vector_t bullet_pos = body_get_centroid(body);
-            if (bullet_pos.y - BULLET_RADIUS < MIN.y) {
-                scene_remove_body(scene, i);
-                asset_remove_body(body);
-            }
+void remove_offscreen_bullets(scene_t *scene, double camera_y){
+    for (ssize_t i = entity_count(ENTITY_BULLET) - 1; i >= 0; i--) {
+        body_t *body = entity_get(ENTITY_BULLET, i);
+        vector_t bullet_pos = body_get_centroid(body);
+        if (bullet_pos.y - BULLET_RADIUS < camera_y + MIN.y) {
+            bullet_pool_release(body);
         }
     }
 }
@@ -170,17 +217,13 @@ void remove_offscreen_bullets(scene_t *scene){
  * detection of a collision
  */
 bool check_villain_bullet_collision(scene_t *scene, body_t *user){
-    for (size_t i = 1; i < scene_bodies(scene); i++){
-        body_t *body = scene_get_body(scene, i);
-        void *info = body_get_info(body);
-
-        if (info != NULL && (strcmp((char *)info, BULLET_INFO) == 0)){
+    for (size_t i = 0; i < entity_count(ENTITY_BULLET); i++){
+        body_t *body = entity_get(ENTITY_BULLET, i);
         collision_info_t collision_info = find_collision(user, body);
 
         if (collision_info.collided == true){
             SDL_play_sound(USER_DEATH_SOUND_PATH);
             return true;
-            }
         }
     }
     return false;
@@ -191,25 +234,28 @@ bool check_villain_bullet_collision(scene_t *scene, body_t *user){
  * time the function is called and utilizes the
  * neccessary helper fucntions on the villain.abort
  * 
- * @param villain a double pointer to the villain of the state
+ * @param villain a handle to the villain of the state, or ENTITY_NO_HANDLE
+ * before it spawns. Set when the villain spawns.
  * @param score the current score of the game
  * @param scene the scene of the game 
  * @param dt the rate at which the game is changing
+ * @param camera_y the world height of the bottom of the view
  * 
  */
-void update_villain(body_t **villain, uint16_t score, scene_t *scene, double dt){
+void update_villain(entity_handle_t *villain, uint16_t score, scene_t *scene, double dt, double camera_y){
     static double bullet_cooldown = 0.0;
-    if (*villain == NULL && score >= 2000){
-        villain_init(scene, villain);
+    if (entity_get_body(*villain) == NULL && score >= 2000){
+        villain_init(scene, villain, camera_y);
     }
 
-    if (*villain != NULL){
-        remove_offscreen_bullets(scene);
-        villain_hover(villain);
+    body_t *villain_body = entity_get_body(*villain);
+    if (villain_body != NULL){
+        remove_offscreen_bullets(scene, camera_y);
+        villain_hover(&villain_body);
         bullet_cooldown += dt;
 
         if (bullet_cooldown >= 3.0){
-            villain_shoot_bullet(scene, *villain, score);
+            villain_shoot_bullet(scene, villain_body, score);
             bullet_cooldown = 0.0;
         }
     }